@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cmath>
+#include <audio.h>
+#include "benchmark.h"
+#include "../environment.h"
+
+namespace skyline::benchmark {
+    namespace {
+        /**
+         * @return A buffer with a sine wave on every channel, the channels are phase shifted from each other
+         */
+        std::vector<i16> GenerateSamples(size_t frameCount, u8 channelCount) {
+            std::vector<i16> samples(frameCount * channelCount);
+            for (size_t frame{}; frame < frameCount; frame++)
+                for (u8 channel{}; channel < channelCount; channel++)
+                    samples[(frame * channelCount) + channel] = static_cast<i16>(std::sin(static_cast<double>(frame + (channel * 16)) * 0.05) * 16384);
+            return samples;
+        }
+
+        /**
+         * @brief Resamples a 32 KHz stereo buffer to the output sample rate, this is done for every buffer appended to a track at a rate other than 48 KHz
+         */
+        void BenchmarkResampler(Runner &runner) {
+            constexpr u32 InputSampleRate{32000};
+            constexpr size_t FrameCount{InputSampleRate / 100}; // 10ms of audio
+            auto input{GenerateSamples(FrameCount, constant::ChannelCount)};
+
+            audio::Resampler resampler;
+            std::vector<i16> output;
+            runner.Run("audio.resampler.resample_32k_to_48k", Work{input.size() * sizeof(i16), FrameCount}, [&] {
+                resampler.ResampleBuffer(input, static_cast<double>(InputSampleRate) / constant::SampleRate, constant::ChannelCount, output);
+            });
+        }
+
+        /**
+         * @brief Mixes several playing tracks into an output buffer in the same way the output stream callback does
+         * @note IAudioRenderer::MixFinalBuffer only runs inside of the renderer service, the final mix of the output callback which every track goes through is measured instead
+         */
+        void BenchmarkMix(Runner &runner, Environment &environment) {
+            constexpr size_t TrackCount{4};
+            constexpr size_t FrameCount{oboe::AudioStream::FramesPerBurst};
+
+            auto &audio{*environment.state.audio};
+            std::vector<std::shared_ptr<audio::AudioTrack>> tracks;
+            for (size_t index{}; index < TrackCount; index++) {
+                auto &track{tracks.emplace_back(audio.OpenTrack(constant::ChannelCount, constant::SampleRate, [] {}))};
+                track->Start();
+            }
+
+            auto samples{GenerateSamples(FrameCount, constant::ChannelCount)};
+            std::vector<i16> output(FrameCount * constant::ChannelCount);
+            oboe::AudioStream stream(&audio, constant::ChannelCount, constant::SampleRate, FrameCount); // The stream is never started, it's only used to describe the output to the callback
+
+            u64 tag{};
+            runner.Run("audio.mix.4_tracks", Work{output.size() * sizeof(i16) * TrackCount, FrameCount * TrackCount}, [&] {
+                for (auto &track : tracks)
+                    track->AppendBuffer(tag, samples);
+                tag++;
+
+                audio.onAudioReady(&stream, output.data(), FrameCount);
+
+                // The audio output service collects released buffers in response to the release callback, the track would otherwise keep track of every buffer
+                for (auto &track : tracks)
+                    track->GetReleasedBuffers(4);
+            });
+
+            for (auto &track : tracks)
+                audio.CloseTrack(track);
+        }
+    }
+
+    void RunAudioBenchmarks(Runner &runner, Environment &environment) {
+        BenchmarkResampler(runner);
+        BenchmarkMix(runner, environment);
+    }
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <common.h>
+
+namespace skyline::host {
+    class Environment;
+    class MemoryBacking;
+}
+
+namespace skyline::benchmark {
+    using host::Environment;
+    using host::MemoryBacking;
+
+    /**
+     * @brief The amount of allocations made by the process, this is maintained by the replacement global allocation functions of the benchmark executable
+     */
+    struct AllocationCounter {
+        static std::atomic<u64> count; //!< The amount of calls to any operator new
+        static std::atomic<u64> bytes; //!< The total amount of bytes requested from any operator new
+    };
+
+    /**
+     * @brief The amount of work done by a single iteration of a benchmark, this is used to derive its throughput
+     */
+    struct Work {
+        u64 bytes; //!< The amount of bytes processed
+        u64 items; //!< The amount of discrete items processed, such as methods or samples
+    };
+
+    /**
+     * @brief The Runner class times benchmarks and reports their results as JSON lines on stdout
+     * @note Every line is an object with the keys "name", "iterations", "ns_per_iteration", "bytes_per_second", "items_per_second", "allocations_per_iteration" and "allocated_bytes_per_iteration" in that order
+     */
+    class Runner {
+      private:
+        std::string filter; //!< A substring of the names of the benchmarks to run, every benchmark is run if this is empty
+        std::chrono::nanoseconds minTime; //!< The minimum amount of time to run every benchmark for
+
+        void Report(std::string_view name, u64 iterations, std::chrono::nanoseconds time, Work work, u64 allocations, u64 allocatedBytes);
+
+      public:
+        Runner(std::string filter, std::chrono::nanoseconds minTime) : filter(std::move(filter)), minTime(minTime) {}
+
+        /**
+         * @return If a benchmark with the supplied name should be run
+         */
+        bool Enabled(std::string_view name) const {
+            return filter.empty() || name.find(filter) != std::string_view::npos;
+        }
+
+        /**
+         * @brief Runs an iteration function in batches of increasing size until the minimum time has elapsed and reports the result
+         * @param work The amount of work done by a single call to the iteration function
+         * @note The iteration function is called once prior to timing, allocations that are only done on the first call aren't counted
+         */
+        template<typename Function>
+        void Run(std::string_view name, Work work, Function &&iteration) {
+            if (!Enabled(name))
+                return;
+
+            iteration();
+
+            auto allocations{AllocationCounter::count.load(std::memory_order_relaxed)};
+            auto allocatedBytes{AllocationCounter::bytes.load(std::memory_order_relaxed)};
+            auto start{std::chrono::steady_clock::now()};
+
+            u64 iterations{};
+            std::chrono::nanoseconds elapsed{};
+            for (u64 batch{1}; elapsed < minTime; batch *= 2) {
+                for (u64 index{}; index < batch; index++)
+                    iteration();
+                iterations += batch;
+                elapsed = std::chrono::steady_clock::now() - start;
+            }
+
+            Report(name, iterations, elapsed, work, AllocationCounter::count.load(std::memory_order_relaxed) - allocations, AllocationCounter::bytes.load(std::memory_order_relaxed) - allocatedBytes);
+        }
+    };
+
+    void RunGpuBenchmarks(Runner &runner, Environment &environment);
+
+    void RunKernelBenchmarks(Runner &runner, Environment &environment);
+
+    void RunVfsBenchmarks(Runner &runner, Environment &environment);
+
+    void RunAudioBenchmarks(Runner &runner, Environment &environment);
+
+    void RunLoaderBenchmarks(Runner &runner, Environment &environment);
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <gpu.h>
+#include <gpu/format.h>
+#include <gpu/macro_interpreter.h>
+#include "benchmark.h"
+#include "../environment.h"
+
+namespace skyline::benchmark {
+    namespace {
+        /**
+         * @brief Deswizzles a block-linear 720p RGBA8888 surface, this is done for every frame that's presented
+         */
+        void BenchmarkTexture(Runner &runner, Environment &environment) {
+            constexpr gpu::texture::Dimensions Dimensions{1280, 720};
+            gpu::texture::Format format{gpu::format::RGBA8888Unorm};
+
+            auto memory{environment.AllocateGuest(format.GetSize(Dimensions))};
+            auto guestMemory{Environment::Span(memory)};
+            for (size_t index{}; index < guestMemory.size(); index++)
+                guestMemory[index] = static_cast<u8>(index * 7);
+
+            gpu::texture::TileConfig tileConfig{};
+            tileConfig.blockHeight = 16;
+            tileConfig.blockDepth = 1;
+            tileConfig.surfaceWidth = Dimensions.width;
+            auto guest{std::make_shared<gpu::GuestTexture>(environment.state, memory->guest.address, Dimensions, format, gpu::texture::TileMode::Block, tileConfig)};
+            auto texture{guest->InitializeTexture()};
+
+            runner.Run("gpu.texture.synchronize_host.block_linear_720p", Work{guest->Size(), Dimensions.width * Dimensions.height}, [&] {
+                texture->SynchronizeHost();
+            });
+        }
+
+        /**
+         * @brief Encoders for macro instructions, the fields which aren't used by an operation are left as zero
+         */
+        namespace macro {
+            constexpr u32 AluRegister{0}, AddImmediate{1}, Branch{7}; //!< Operations
+            constexpr u32 IgnoreAndFetch{0}, Move{1}, MoveAndSetMethod{2}, MoveAndSend{4}; //!< Assignment operations
+            constexpr u32 Add{0}; //!< ALU operations
+
+            constexpr u32 Immediate(u32 operation, u32 assignment, u32 dest, u32 srcA, i32 immediate) {
+                return operation | (assignment << 4) | (dest << 8) | (srcA << 11) | (static_cast<u32>(immediate) << 14);
+            }
+
+            constexpr u32 Alu(u32 assignment, u32 dest, u32 srcA, u32 srcB, u32 alu) {
+                return AluRegister | (assignment << 4) | (dest << 8) | (srcA << 11) | (srcB << 14) | (alu << 17);
+            }
+
+            constexpr u32 BranchNonZeroNoDelay(u32 srcA, i32 offset) {
+                return Branch | (1 << 4) | (1 << 5) | (srcA << 11) | (static_cast<u32>(offset) << 14);
+            }
+
+            constexpr u32 Exit{Immediate(AddImmediate, Move, 0, 0, 0) | (1 << 7)};
+            constexpr u32 Nop{Immediate(AddImmediate, Move, 0, 0, 0)};
+        }
+
+        /**
+         * @brief Runs a macro which loops over its arguments and sends each of them to a Maxwell 3D register, this is representative of the draw macros games use
+         */
+        void BenchmarkMacroInterpreter(Runner &runner, Environment &environment) {
+            using namespace macro;
+            constexpr u32 TargetMethod{0x300}; // The first viewport register, writes to it have no side effects
+            constexpr std::array<u32, 7> Program{
+                Immediate(AddImmediate, MoveAndSetMethod, 2, 0, TargetMethod), // r2 = method(TargetMethod)
+                Immediate(AddImmediate, IgnoreAndFetch, 3, 0, 0), // r3 = argument
+                Alu(MoveAndSend, 4, 3, 1, Add), // send(r3 + r1)
+                Immediate(AddImmediate, Move, 1, 1, -1), // r1 -= 1
+                BranchNonZeroNoDelay(1, -3), // if (r1) goto 1
+                Exit,
+                Nop, // Exit delay slot
+            };
+
+            auto &maxwell3D{*environment.state.gpu->maxwell3D};
+            std::copy(Program.begin(), Program.end(), maxwell3D.macroCode.begin());
+
+            constexpr u32 SendCount{256};
+            std::vector<u32> arguments(SendCount + 1);
+            arguments[0] = SendCount;
+            for (u32 index{1}; index <= SendCount; index++)
+                arguments[index] = index;
+
+            gpu::MacroInterpreter interpreter(maxwell3D);
+            runner.Run("gpu.macro_interpreter.execute", Work{Program.size() * sizeof(u32), SendCount}, [&] {
+                interpreter.Execute(0, arguments);
+            });
+        }
+
+        /**
+         * @brief Decodes a pushbuffer made up of incrementing, non-incrementing and immediate methods to Maxwell 3D registers
+         */
+        void BenchmarkGpfifo(Runner &runner, Environment &environment) {
+            using Header = gpu::gpfifo::PushBufferMethodHeader;
+            auto header{[](Header::SecOp secOp, u32 count, u32 method) {
+                return (static_cast<u32>(secOp) << 29) | (count << 16) | method; // The methods are all sent to subchannel 0
+            }};
+
+            std::vector<u32> pushbuffer{header(Header::SecOp::IncMethod, 1, 0), static_cast<u32>(gpu::EngineID::Maxwell3D)};
+            u64 methodCount{1};
+
+            constexpr u32 TargetMethod{0x300};
+            constexpr u32 SequenceLength{16};
+            for (u32 sequence{}; sequence < 64; sequence++) {
+                switch (sequence % 3) {
+                    case 0:
+                        pushbuffer.push_back(header(Header::SecOp::IncMethod, SequenceLength, TargetMethod));
+                        break;
+                    case 1:
+                        pushbuffer.push_back(header(Header::SecOp::NonIncMethod, SequenceLength, TargetMethod));
+                        break;
+                    default:
+                        pushbuffer.push_back(header(Header::SecOp::ImmdDataMethod, sequence, TargetMethod));
+                        methodCount++;
+                        continue;
+                }
+
+                for (u32 index{}; index < SequenceLength; index++)
+                    pushbuffer.push_back(sequence * SequenceLength + index);
+                methodCount += SequenceLength;
+            }
+
+            auto memory{environment.AllocateGuest(constant::GpuPageSize)};
+            std::copy(pushbuffer.begin(), pushbuffer.end(), Environment::Span<u32>(memory).begin());
+
+            auto &gpu{*environment.state.gpu};
+            constexpr u64 GpuAddress{0x10000000};
+            if (!gpu.memoryManager.MapFixed(GpuAddress, memory->guest.address, memory->guest.size))
+                throw exception("Failed to map the pushbuffer into the GPU address space");
+
+            gpu::gpfifo::GpEntry entry{};
+            entry.get = static_cast<u32>(GpuAddress >> 2);
+            entry.getHi = static_cast<u8>(GpuAddress >> 32);
+            entry.size = static_cast<u32>(pushbuffer.size());
+
+            runner.Run("gpu.gpfifo.process", Work{pushbuffer.size() * sizeof(u32), methodCount}, [&] {
+                gpu.gpfifo.Push(std::span(&entry, 1));
+                gpu.gpfifo.Run();
+            });
+        }
+    }
+
+    void RunGpuBenchmarks(Runner &runner, Environment &environment) {
+        BenchmarkTexture(runner, environment);
+        BenchmarkMacroInterpreter(runner, environment);
+        BenchmarkGpfifo(runner, environment);
+    }
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <kernel/ipc.h>
+#include <kernel/types/KProcess.h>
+#include "benchmark.h"
+#include "../environment.h"
+
+namespace skyline::benchmark {
+    namespace {
+        /**
+         * @brief Writes a request with a copied handle, one of each X, A, B and C buffer descriptors and a 16 byte payload into the TLS of the main thread, this is typical of requests to the filesystem services
+         */
+        void WriteIpcRequest(const DeviceState &state) {
+            using namespace kernel::ipc;
+            constexpr u64 BufferAddress{0x80000000}; // Buffers are never accessed while parsing so they don't need to be backed by memory
+            constexpr u32 ArgumentSize{0x10};
+
+            auto tls{state.process->GetPointer<u8>(state.thread->tls)};
+            std::memset(tls, 0, constant::TlsIpcSize);
+            auto pointer{tls};
+
+            auto header{reinterpret_cast<CommandHeader *>(pointer)};
+            header->type = CommandType::Request;
+            header->xNo = header->aNo = header->bNo = 1;
+            header->cFlag = BufferCFlag::SingleDescriptor;
+            header->handleDesc = true;
+            pointer += sizeof(CommandHeader);
+
+            reinterpret_cast<HandleDescriptor *>(pointer)->copyCount = 1;
+            pointer += sizeof(HandleDescriptor);
+            *reinterpret_cast<KHandle *>(pointer) = 0xD000;
+            pointer += sizeof(KHandle);
+
+            auto bufX{reinterpret_cast<BufferDescriptorX *>(pointer)};
+            bufX->address0_31 = static_cast<u32>(BufferAddress);
+            bufX->size = 0x100;
+            pointer += sizeof(BufferDescriptorX);
+
+            for (u8 index{}; index < 2; index++) {
+                auto bufAB{reinterpret_cast<BufferDescriptorABW *>(pointer)};
+                bufAB->address0_31 = static_cast<u32>(BufferAddress + ((index + 1) * 0x1000));
+                bufAB->size0_31 = 0x1000;
+                pointer += sizeof(BufferDescriptorABW);
+            }
+
+            auto offset{static_cast<size_t>(pointer - tls)};
+            auto padding{util::AlignUp(offset, constant::IpcPaddingSum) - offset};
+            pointer += padding;
+
+            auto cBufferLengthSize{util::AlignUp(sizeof(u16), sizeof(u32))};
+            header->rawSize = static_cast<u32>((constant::IpcPaddingSum + sizeof(PayloadHeader) + ArgumentSize + cBufferLengthSize) / sizeof(u32));
+
+            auto payload{reinterpret_cast<PayloadHeader *>(pointer)};
+            payload->magic = util::MakeMagic<u32>("SFCI");
+            payload->value = 8;
+            pointer += sizeof(PayloadHeader) + ArgumentSize + constant::IpcPaddingSum - padding + cBufferLengthSize;
+
+            auto bufC{reinterpret_cast<BufferDescriptorC *>(pointer)};
+            bufC->address = BufferAddress + 0x3000;
+            bufC->size = 0x100;
+        }
+
+        /**
+         * @brief Parses a request from the TLS of the main thread, this is done for every IPC request a guest sends
+         */
+        void BenchmarkIpcRequest(Runner &runner, Environment &environment) {
+            WriteIpcRequest(environment.state);
+
+            runner.Run("kernel.ipc.request_parse", Work{constant::TlsIpcSize, 1}, [&] {
+                kernel::ipc::IpcRequest request(false, environment.state);
+                if (request.payload->value != 8)
+                    throw exception("IPC request was parsed incorrectly");
+            });
+        }
+
+        /**
+         * @brief Writes a response with a moved handle and a 16 byte payload into the TLS of the main thread
+         */
+        void BenchmarkIpcResponse(Runner &runner, Environment &environment) {
+            runner.Run("kernel.ipc.response_write", Work{constant::TlsIpcSize, 1}, [&] {
+                kernel::ipc::IpcResponse response(environment.state);
+                response.Push<u64>(0x1000);
+                response.Push<u64>(0x2000);
+                response.moveHandles.push_back(0xD001);
+                response.WriteResponse(false);
+            });
+        }
+
+        /**
+         * @brief Looks up addresses across a process with a populated memory map, this is done for every guest memory access that isn't to a host mapping
+         */
+        void BenchmarkMemoryGet(Runner &runner, Environment &environment) {
+            constexpr size_t RegionCount{64};
+            constexpr size_t RegionSize{PAGE_SIZE * 4};
+
+            std::vector<std::shared_ptr<kernel::type::KSharedMemory>> regions;
+            std::vector<u64> addresses;
+            for (size_t index{}; index < RegionCount; index++) {
+                auto &region{regions.emplace_back(environment.AllocateGuest(RegionSize))};
+                addresses.push_back(region->guest.address + ((index * PAGE_SIZE) % RegionSize));
+            }
+
+            auto &memory{environment.state.os->memory};
+            runner.Run("kernel.memory_manager.get", Work{0, RegionCount}, [&] {
+                for (auto address : addresses)
+                    if (!memory.Get(address))
+                        throw exception("Memory lookup failed at 0x{:X}", address);
+            });
+        }
+
+        /**
+         * @brief Changes the permissions of every page in a region and restores them, every change splits or merges blocks in the chunk of the region
+         */
+        void BenchmarkMemoryInsertBlock(Runner &runner, Environment &environment) {
+            constexpr size_t PageCount{16};
+            auto region{environment.AllocateGuest(PageCount * PAGE_SIZE)};
+            auto address{region->guest.address};
+
+            runner.Run("kernel.memory_manager.insert_block", Work{0, PageCount * 2}, [&] {
+                for (size_t page{}; page < PageCount; page++)
+                    region->UpdatePermission(address + (page * PAGE_SIZE), PAGE_SIZE, memory::Permission{true, false, false}, false);
+                for (size_t page{}; page < PageCount; page++)
+                    region->UpdatePermission(address + (page * PAGE_SIZE), PAGE_SIZE, memory::Permission{true, true, false}, false);
+            });
+        }
+    }
+
+    void RunKernelBenchmarks(Runner &runner, Environment &environment) {
+        BenchmarkIpcRequest(runner, environment);
+        BenchmarkIpcResponse(runner, environment);
+        BenchmarkMemoryGet(runner, environment);
+        BenchmarkMemoryInsertBlock(runner, environment);
+    }
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <lz4.h>
+#include <loader/nso.h>
+#include "benchmark.h"
+#include "../environment.h"
+
+namespace skyline::benchmark {
+    namespace {
+        /**
+         * @return A segment with a mix of repetitive and random words, this compresses to roughly the same ratio as code does
+         */
+        std::vector<u8> GenerateSegment(size_t size, u32 seed) {
+            std::vector<u8> segment(size);
+            auto words{std::span(reinterpret_cast<u32 *>(segment.data()), size / sizeof(u32))};
+            for (size_t index{}; index < words.size(); index++) {
+                seed = (seed * 1103515245) + 12345;
+                words[index] = (seed & 0x30000) ? (0xD503201F + ((seed >> 8) & 0x1F)) : seed;
+            }
+            return segment;
+        }
+
+        /**
+         * @brief Creates an NSO with LZ4 compressed .text, .rodata and .data segments
+         * @url https://switchbrew.org/wiki/NSO
+         */
+        std::vector<u8> CreateNso(const std::array<std::vector<u8>, 3> &segments) {
+            constexpr size_t HeaderSize{0x100};
+            std::vector<u8> nso(HeaderSize);
+            auto write{[&nso](size_t offset, u32 value) {
+                std::memcpy(nso.data() + offset, &value, sizeof(u32));
+            }};
+
+            write(0x0, util::MakeMagic<u32>("NSO0"));
+            write(0xC, 0b111); // All segments are compressed and none are hashed
+
+            u32 memoryOffset{};
+            for (size_t index{}; index < segments.size(); index++) {
+                auto &segment{segments[index]};
+                std::vector<u8> compressed(LZ4_compressBound(static_cast<int>(segment.size())));
+                auto compressedSize{LZ4_compress_default(reinterpret_cast<const char *>(segment.data()), reinterpret_cast<char *>(compressed.data()), static_cast<int>(segment.size()), static_cast<int>(compressed.size()))};
+                if (compressedSize <= 0)
+                    throw exception("Failed to compress NSO segment {}", index);
+
+                auto segmentHeader{0x10 + (index * 0x10)};
+                write(segmentHeader, static_cast<u32>(nso.size()));
+                write(segmentHeader + 0x4, memoryOffset);
+                write(segmentHeader + 0x8, static_cast<u32>(segment.size()));
+                write(0x60 + (index * sizeof(u32)), static_cast<u32>(compressedSize));
+
+                nso.insert(nso.end(), compressed.begin(), compressed.begin() + compressedSize);
+                memoryOffset += util::AlignUp(segment.size(), PAGE_SIZE);
+            }
+
+            return nso;
+        }
+
+        /**
+         * @brief Reads and decompresses every segment of an NSO, this is done for every NSO of an application at boot
+         */
+        void BenchmarkNsoDecompression(Runner &runner, Environment &environment) {
+            std::array<std::vector<u8>, 3> segments{GenerateSegment(0x800000, 1), GenerateSegment(0x200000, 2), GenerateSegment(0x80000, 3)};
+            size_t decompressedSize{};
+            for (auto &segment : segments)
+                decompressedSize += segment.size();
+
+            std::shared_ptr<vfs::Backing> backing{std::make_shared<MemoryBacking>(CreateNso(segments))};
+            runner.Run("loader.nso.read_lz4", Work{decompressedSize, segments.size()}, [&] {
+                auto executable{loader::NsoLoader::ReadNso(backing, environment.state)};
+                if (executable.text.contents.size() < segments[0].size())
+                    throw exception("NSO .text was decompressed incorrectly");
+            });
+        }
+    }
+
+    void RunLoaderBenchmarks(Runner &runner, Environment &environment) {
+        BenchmarkNsoDecompression(runner, environment);
+    }
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include "benchmark.h"
+#include "../environment.h"
+
+namespace skyline::benchmark {
+    std::atomic<u64> AllocationCounter::count;
+    std::atomic<u64> AllocationCounter::bytes;
+
+    void Runner::Report(std::string_view name, u64 iterations, std::chrono::nanoseconds time, Work work, u64 allocations, u64 allocatedBytes) {
+        auto seconds{std::chrono::duration<double>(time).count()};
+        auto perIteration{[iterations](u64 value) { return static_cast<double>(value) / static_cast<double>(iterations); }};
+
+        fmt::print(R"({{"name":"{}","iterations":{},"ns_per_iteration":{:.1f},"bytes_per_second":{:.0f},"items_per_second":{:.0f},"allocations_per_iteration":{:.2f},"allocated_bytes_per_iteration":{:.1f}}})" "\n",
+                   name, iterations, static_cast<double>(time.count()) / static_cast<double>(iterations), static_cast<double>(work.bytes * iterations) / seconds, static_cast<double>(work.items * iterations) / seconds, perIteration(allocations), perIteration(allocatedBytes));
+        std::fflush(stdout);
+    }
+}
+
+// Every allocation in the process goes through these so benchmarks can report how many allocations their hot path performs
+void *operator new(size_t size) {
+    skyline::benchmark::AllocationCounter::count.fetch_add(1, std::memory_order_relaxed);
+    skyline::benchmark::AllocationCounter::bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (auto pointer{std::malloc(size ? size : 1)})
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+    skyline::benchmark::AllocationCounter::count.fetch_add(1, std::memory_order_relaxed);
+    skyline::benchmark::AllocationCounter::bytes.fetch_add(size, std::memory_order_relaxed);
+
+    auto alignmentValue{static_cast<size_t>(alignment)};
+    if (auto pointer{std::aligned_alloc(alignmentValue, skyline::util::AlignUp(size ? size : 1, alignmentValue))})
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * @brief Runs all benchmarks with names containing the optional filter argument, the minimum time per benchmark in milliseconds can be supplied with --min-time
+ */
+int main(int argc, char **argv) {
+    using namespace skyline::benchmark;
+
+    std::string filter;
+    std::chrono::milliseconds minTime{500};
+    for (int index{1}; index < argc; index++) {
+        std::string_view argument{argv[index]};
+        if (argument == "--min-time" && index + 1 < argc)
+            minTime = std::chrono::milliseconds(std::strtoull(argv[++index], nullptr, 10));
+        else
+            filter = argument;
+    }
+
+    try {
+        Runner runner(filter, minTime);
+        Environment environment;
+
+        RunGpuBenchmarks(runner, environment);
+        RunKernelBenchmarks(runner, environment);
+        RunVfsBenchmarks(runner, environment);
+        RunAudioBenchmarks(runner, environment);
+        RunLoaderBenchmarks(runner, environment);
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "Benchmark failed: %s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <vfs/ctr_encrypted_backing.h>
+#include "benchmark.h"
+#include "../environment.h"
+
+namespace skyline::benchmark {
+    namespace {
+        /**
+         * @brief Decrypts an AES-CTR section with both large aligned reads and small unaligned reads, these are how RomFS data and RomFS metadata are read respectively
+         */
+        void BenchmarkCtrEncryptedBacking(Runner &runner) {
+            constexpr size_t SectionSize{0x400000};
+            std::vector<u8> section(SectionSize);
+            for (size_t index{}; index < section.size(); index++)
+                section[index] = static_cast<u8>((index * 0x9E3779B1) >> 24);
+
+            crypto::KeyStore::Key128 ctr{};
+            crypto::KeyStore::Key128 key{0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+            vfs::CtrEncryptedBacking backing(ctr, key, std::make_shared<MemoryBacking>(std::move(section)), 0x4000);
+
+            constexpr size_t LargeReadSize{0x100000};
+            std::vector<u8> output(LargeReadSize);
+            size_t offset{};
+            runner.Run("vfs.ctr_encrypted_backing.read_1mib", Work{LargeReadSize, 1}, [&] {
+                backing.Read(output.data(), offset, LargeReadSize);
+                offset = (offset + LargeReadSize) % SectionSize;
+            });
+
+            constexpr size_t SmallReadSize{0x4C};
+            constexpr size_t SmallReadStride{0x1F3}; // The reads are spread across blocks and never start at the beginning of one
+            offset = 0;
+            runner.Run("vfs.ctr_encrypted_backing.read_unaligned_76b", Work{SmallReadSize, 1}, [&] {
+                backing.Read(output.data(), offset, SmallReadSize);
+                offset = (offset + SmallReadStride) % (SectionSize - SmallReadSize);
+            });
+        }
+    }
+
+    void RunVfsBenchmarks(Runner &runner, Environment &environment) {
+        BenchmarkCtrEncryptedBacking(runner);
+    }
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <csignal>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <kernel/types/KProcess.h>
+#include "environment.h"
+
+namespace skyline::host {
+    namespace {
+        /**
+         * @brief The preferences the core reads, these match the defaults of the Android frontend
+         */
+        constexpr std::string_view Preferences{R"(<?xml version='1.0' encoding='utf-8' standalone='yes' ?>
+<map>
+    <string name="audio_performance_mode">0</string>
+    <string name="audio_buffer_bursts">0</string>
+    <boolean name="operation_mode" value="true" />
+    <string name="username_value">Skyline</string>
+    <boolean name="nso_hash_check" value="false" />
+    <boolean name="gpu_capture" value="false" />
+</map>
+)"};
+
+        std::shared_ptr<Settings> CreateSettings() {
+            int fd{memfd_create("preferences.xml", MFD_CLOEXEC)};
+            if (fd < 0)
+                throw exception("Failed to create the preferences file: {}", strerror(errno));
+
+            if (write(fd, Preferences.data(), Preferences.size()) != static_cast<ssize_t>(Preferences.size()) || lseek(fd, 0, SEEK_SET))
+                throw exception("Failed to write the preferences file: {}", strerror(errno));
+
+            return std::make_shared<Settings>(fd);
+        }
+    }
+
+    Environment::Environment() : jvm(std::make_shared<JvmManager>(nullptr, nullptr)), settings(CreateSettings()), logger(std::make_shared<Logger>("/dev/null", Logger::LogLevel::Error)), os(std::make_unique<kernel::OS>(jvm, logger, settings, "/tmp/")), state(os->state) {
+        placeholderPid = fork();
+        if (placeholderPid == 0) {
+            while (true)
+                pause();
+        } else if (placeholderPid < 0) {
+            throw exception("Failed to create the placeholder process: {}", strerror(errno));
+        }
+
+        constexpr size_t StackSize{0x10000}; // The size of the stack of the main thread, it's never used as no guest code runs
+        auto stack{std::make_shared<kernel::type::KSharedMemory>(state, 0, StackSize, memory::Permission{true, true, false}, memory::states::Stack, 0, true)};
+        auto threadContext{std::make_shared<kernel::type::KSharedMemory>(state, 0, util::AlignUp(sizeof(ThreadContext), PAGE_SIZE), memory::Permission{true, true, false}, memory::states::Reserved)};
+        os->process = std::make_shared<kernel::type::KProcess>(state, placeholderPid, 0, stack, threadContext);
+
+        // The TLS of the main thread holds the IPC command buffer, it's a page of guest memory as the process can't reserve TLS slots without guest memory regions
+        auto tls{AllocateGuest(PAGE_SIZE)};
+        state.thread = os->process->threads.at(placeholderPid);
+        state.thread->tls = tls->guest.address;
+        os->process->InsertItem(tls);
+    }
+
+    Environment::~Environment() {
+        // The process has to be destroyed while the memory manager its objects unregister themselves from is still alive
+        state.thread.reset();
+        os->process.reset();
+        os.reset();
+
+        kill(placeholderPid, SIGKILL);
+        waitpid(placeholderPid, nullptr, 0);
+    }
+
+    std::shared_ptr<kernel::type::KSharedMemory> Environment::AllocateGuest(size_t size) {
+        return std::make_shared<kernel::type::KSharedMemory>(state, 0, util::AlignUp(size, PAGE_SIZE), memory::Permission{true, true, false}, memory::states::SharedMemory, 0, true);
+    }
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <os.h>
+#include <jvm.h>
+#include <vfs/backing.h>
+#include <kernel/types/KSharedMemory.h>
+
+namespace skyline::host {
+    /**
+     * @brief A read-only backing over a buffer in memory, this is used to feed synthetic files to the VFS and loaders
+     */
+    class MemoryBacking : public vfs::Backing {
+      private:
+        std::vector<u8> data;
+
+      public:
+        MemoryBacking(std::vector<u8> data) : Backing({true, false, false}, data.size()), data(std::move(data)) {}
+
+        size_t Read(u8 *output, size_t offset, size_t size) override {
+            if (offset >= data.size())
+                return 0;
+
+            size = std::min(size, data.size() - offset);
+            std::memcpy(output, data.data() + offset, size);
+            return size;
+        }
+
+        u8 *GetMapping() override {
+            return data.data();
+        }
+    };
+
+    /**
+     * @brief The Environment class sets up a device state with a guest process for host tools to run against
+     * @note There's no guest code on a host, the process belongs to a placeholder child that only exists so the kernel objects backing the process can be created, all guest memory is shared memory which is mapped at the same address in the host process
+     */
+    class Environment {
+      private:
+        std::shared_ptr<JvmManager> jvm;
+        std::shared_ptr<Settings> settings;
+        std::shared_ptr<Logger> logger;
+        pid_t placeholderPid{-1}; //!< The PID of the child process which stands in for the guest process
+
+      public:
+        std::unique_ptr<kernel::OS> os;
+        DeviceState &state;
+
+        Environment();
+
+        ~Environment();
+
+        /**
+         * @brief Allocates a region of guest memory which is accessible at the same address from the host
+         * @note The region stays mapped for as long as the returned object is alive
+         */
+        std::shared_ptr<kernel::type::KSharedMemory> AllocateGuest(size_t size);
+
+        /**
+         * @return A span over a region of guest memory allocated with AllocateGuest
+         */
+        template<typename Type = u8>
+        static std::span<Type> Span(const std::shared_ptr<kernel::type::KSharedMemory> &memory) {
+            return std::span(reinterpret_cast<Type *>(memory->guest.address), memory->guest.size / sizeof(Type));
+        }
+    };
+}
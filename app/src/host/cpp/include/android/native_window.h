@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file A stand-in for the NDK ANativeWindow API used by host builds, windows are backed by memory and can optionally dump every posted frame to a file
+ */
+
+enum {
+    WINDOW_FORMAT_RGBA_8888 = 1,
+    WINDOW_FORMAT_RGBX_8888 = 2,
+    WINDOW_FORMAT_RGB_565 = 4,
+};
+
+struct ANativeWindow;
+
+struct ARect {
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+};
+
+struct ANativeWindow_Buffer {
+    int32_t width;
+    int32_t height;
+    int32_t stride; //!< The stride of the buffer in pixels
+    int32_t format;
+    void *bits;
+    uint32_t reserved[6];
+};
+
+void ANativeWindow_acquire(ANativeWindow *window);
+
+void ANativeWindow_release(ANativeWindow *window);
+
+int32_t ANativeWindow_getWidth(ANativeWindow *window);
+
+int32_t ANativeWindow_getHeight(ANativeWindow *window);
+
+int32_t ANativeWindow_getFormat(ANativeWindow *window);
+
+int32_t ANativeWindow_setBuffersGeometry(ANativeWindow *window, int32_t width, int32_t height, int32_t format);
+
+int32_t ANativeWindow_lock(ANativeWindow *window, ANativeWindow_Buffer *outBuffer, ARect *inOutDirtyBounds);
+
+int32_t ANativeWindow_unlockAndPost(ANativeWindow *window);
@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <jni.h>
+#include "native_window.h"
+
+/**
+ * @return A new window with a reference held by the caller, the surface is ignored as there are none on a host
+ * @note The window is 1280x720 RGBA8888 by default, if the SKYLINE_FRAME_DUMP environment variable is set then every posted frame is appended to the file it names
+ */
+ANativeWindow *ANativeWindow_fromSurface(JNIEnv *env, jobject surface);
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Creates an anonymous shared memory region, on a host this is backed by a memfd
+ * @return A file descriptor to the region or a negative value on failure
+ */
+int ASharedMemory_create(const char *name, size_t size);
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+/**
+ * @file Definitions of the bionic-specific macros used by the core, this is force-included into every host translation unit
+ */
+
+#include <climits>
+
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 4096
+#endif
+
+#ifndef WORD_BIT
+#define WORD_BIT 32
+#endif
+
+#ifndef __noreturn
+#define __noreturn __attribute__((__noreturn__))
+#endif
+
+#ifndef __predict_true
+#define __predict_true(expression) __builtin_expect((expression) != 0, 1)
+#endif
+
+#ifndef __predict_false
+#define __predict_false(expression) __builtin_expect((expression) != 0, 0)
+#endif
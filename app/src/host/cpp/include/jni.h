@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file A null stand-in for the JNI header used by host builds, it only has the types and functions the core uses outside of the JNI glue
+ * @note There's no Java VM on a host, all field accessors return zero-initialized values
+ */
+
+typedef uint8_t jboolean;
+typedef int8_t jbyte;
+typedef uint16_t jchar;
+typedef int16_t jshort;
+typedef int32_t jint;
+typedef int64_t jlong;
+typedef float jfloat;
+typedef double jdouble;
+typedef jint jsize;
+
+typedef struct _jobject *jobject;
+typedef jobject jclass;
+typedef jobject jstring;
+typedef struct _jfieldID *jfieldID;
+typedef struct _jmethodID *jmethodID;
+
+#define JNIEXPORT __attribute__((visibility("default")))
+#define JNICALL
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+
+struct JavaVM {};
+
+/**
+ * @brief A JNI environment that isn't backed by a Java VM
+ */
+struct JNIEnv {
+    jfieldID GetFieldID(jclass, const char *, const char *) {
+        return nullptr;
+    }
+
+    jobject GetObjectField(jobject, jfieldID) {
+        return nullptr;
+    }
+
+    jboolean GetBooleanField(jobject, jfieldID) {
+        return JNI_FALSE;
+    }
+
+    jbyte GetByteField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jchar GetCharField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jshort GetShortField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jint GetIntField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jlong GetLongField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jfloat GetFloatField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jdouble GetDoubleField(jobject, jfieldID) {
+        return 0;
+    }
+
+    jboolean IsSameObject(jobject object1, jobject object2) {
+        return object1 == object2;
+    }
+};
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+/**
+ * @file A null stand-in for the subset of oboe used by host builds, streams consume audio at the real-time rate and discard it
+ */
+namespace oboe {
+    enum class AudioFormat : int32_t {
+        Invalid = -1,
+        Unspecified = 0,
+        I16 = 1,
+        Float = 2,
+    };
+
+    enum class PerformanceMode : int32_t {
+        None = 10,
+        PowerSaving = 11,
+        LowLatency = 12,
+    };
+
+    enum class Usage : int32_t {
+        Media = 1,
+        Game = 14,
+    };
+
+    enum class DataCallbackResult : int32_t {
+        Continue = 0,
+        Stop,
+    };
+
+    enum class Result : int32_t {
+        OK = 0,
+        ErrorDisconnected = -899,
+        ErrorInvalidState = -895,
+    };
+
+    constexpr int32_t Unspecified{0};
+
+    /**
+     * @brief Either a value or the error that prevented it from being produced
+     */
+    template<typename T>
+    class ResultWithValue {
+      private:
+        T mValue{};
+        Result mError{Result::OK};
+
+      public:
+        ResultWithValue(T value) : mValue(value) {}
+
+        ResultWithValue(Result error) : mError(error) {}
+
+        T value() const {
+            return mValue;
+        }
+
+        Result error() const {
+            return mError;
+        }
+
+        explicit operator bool() const {
+            return mError == Result::OK;
+        }
+    };
+
+    class AudioStream;
+
+    class AudioStreamCallback {
+      public:
+        virtual ~AudioStreamCallback() = default;
+
+        virtual DataCallbackResult onAudioReady(AudioStream *audioStream, void *audioData, int32_t numFrames) = 0;
+
+        virtual void onErrorAfterClose(AudioStream *audioStream, Result error) {}
+    };
+
+    /**
+     * @brief A stream that periodically invokes its callback from a thread of its own and discards the produced audio
+     */
+    class AudioStream {
+      private:
+        AudioStreamCallback *callback;
+        int32_t channelCount;
+        int32_t sampleRate;
+        int32_t framesPerCallback;
+        int32_t bufferSize; //!< The size of the buffer in frames, this doesn't affect the null stream beyond being reported back
+        std::thread thread;
+        std::atomic<bool> running{};
+
+        void Run();
+
+      public:
+        static constexpr int32_t FramesPerBurst{192}; //!< The amount of frames consumed in a burst, this matches common Android devices
+
+        AudioStream(AudioStreamCallback *callback, int32_t channelCount, int32_t sampleRate, int32_t framesPerCallback);
+
+        ~AudioStream();
+
+        int32_t getChannelCount() const {
+            return channelCount;
+        }
+
+        int32_t getSampleRate() const {
+            return sampleRate;
+        }
+
+        AudioFormat getFormat() const {
+            return AudioFormat::I16;
+        }
+
+        int32_t getFramesPerBurst() const {
+            return FramesPerBurst;
+        }
+
+        int32_t getBufferSizeInFrames() const {
+            return bufferSize;
+        }
+
+        ResultWithValue<int32_t> setBufferSizeInFrames(int32_t requestedFrames) {
+            bufferSize = requestedFrames;
+            return bufferSize;
+        }
+
+        ResultWithValue<int32_t> getXRunCount() const {
+            return 0;
+        }
+
+        Result requestStart();
+
+        Result requestStop();
+    };
+
+    using ManagedStream = std::unique_ptr<AudioStream>;
+
+    class AudioStreamBuilder {
+      private:
+        AudioStreamCallback *callback{};
+        int32_t channelCount{2};
+        int32_t sampleRate{48000};
+        int32_t framesPerCallback{Unspecified};
+
+      public:
+        AudioStreamBuilder *setChannelCount(int32_t pChannelCount) {
+            channelCount = pChannelCount;
+            return this;
+        }
+
+        AudioStreamBuilder *setSampleRate(int32_t pSampleRate) {
+            sampleRate = pSampleRate;
+            return this;
+        }
+
+        AudioStreamBuilder *setFormat(AudioFormat format) {
+            return this;
+        }
+
+        AudioStreamBuilder *setPerformanceMode(PerformanceMode performanceMode) {
+            return this;
+        }
+
+        AudioStreamBuilder *setFramesPerCallback(int32_t pFramesPerCallback) {
+            framesPerCallback = pFramesPerCallback;
+            return this;
+        }
+
+        AudioStreamBuilder *setUsage(Usage usage) {
+            return this;
+        }
+
+        AudioStreamBuilder *setCallback(AudioStreamCallback *pCallback) {
+            callback = pCallback;
+            return this;
+        }
+
+        Result openManagedStream(ManagedStream &stream);
+    };
+}
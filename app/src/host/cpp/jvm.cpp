@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <jvm.h>
+
+// These are defined by the JNI glue on Android, on a host they're placeholders as there's no frontend to drive them
+bool Halt;
+jobject Surface{reinterpret_cast<jobject>(&Surface)}; //!< A non-null placeholder so frames are presented to the stand-in window
+skyline::GroupMutex JniMtx;
+skyline::u16 fps;
+skyline::u32 frametime;
+
+namespace skyline {
+    namespace {
+        JNIEnv nullEnv; //!< The environment returned to every thread, it isn't backed by a Java VM
+    }
+
+    JvmManager::JvmManager(JNIEnv *env, jobject instance) : instance(instance), instanceClass(), initializeControllersId(), vibrateDeviceId(), clearVibrationDeviceId() {}
+
+    JvmManager::~JvmManager() {}
+
+    void JvmManager::AttachThread() {}
+
+    void JvmManager::DetachThread() {}
+
+    JNIEnv *JvmManager::GetEnv() {
+        return &nullEnv;
+    }
+
+    jobject JvmManager::GetField(const char *key, const char *signature) {
+        return nullptr;
+    }
+
+    bool JvmManager::CheckNull(const char *key, const char *signature) {
+        return true;
+    }
+
+    bool JvmManager::CheckNull(jobject &object) {
+        return object == nullptr;
+    }
+
+    void JvmManager::InitializeControllers() {}
+
+    void JvmManager::VibrateDevice(jint index, const std::span<jlong> &timings, const std::span<jint> &amplitudes) {}
+
+    void JvmManager::ClearVibrationDevice(jint index) {}
+}
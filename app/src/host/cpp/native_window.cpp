@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <atomic>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <android/native_window_jni.h>
+
+/**
+ * @brief A window that is backed by memory, posted frames are optionally appended to a file as raw pixel data
+ */
+struct ANativeWindow {
+    std::atomic<int32_t> references{1};
+    int32_t width{1280};
+    int32_t height{720};
+    int32_t format{WINDOW_FORMAT_RGBA_8888};
+    std::vector<uint8_t> buffer;
+    std::ofstream dump; //!< The file frames are dumped into, this isn't open if frames aren't being dumped
+
+    ANativeWindow() {
+        if (auto path{std::getenv("SKYLINE_FRAME_DUMP")})
+            dump.open(path, std::ios::binary | std::ios::trunc);
+    }
+
+    size_t BytesPerPixel() const {
+        return format == WINDOW_FORMAT_RGB_565 ? 2 : 4;
+    }
+};
+
+ANativeWindow *ANativeWindow_fromSurface(JNIEnv *env, jobject surface) {
+    return new ANativeWindow();
+}
+
+void ANativeWindow_acquire(ANativeWindow *window) {
+    window->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ANativeWindow_release(ANativeWindow *window) {
+    if (window->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete window;
+}
+
+int32_t ANativeWindow_getWidth(ANativeWindow *window) {
+    return window->width;
+}
+
+int32_t ANativeWindow_getHeight(ANativeWindow *window) {
+    return window->height;
+}
+
+int32_t ANativeWindow_getFormat(ANativeWindow *window) {
+    return window->format;
+}
+
+int32_t ANativeWindow_setBuffersGeometry(ANativeWindow *window, int32_t width, int32_t height, int32_t format) {
+    if (width < 0 || height < 0)
+        return -1;
+
+    window->width = width;
+    window->height = height;
+    if (format)
+        window->format = format;
+    return 0;
+}
+
+int32_t ANativeWindow_lock(ANativeWindow *window, ANativeWindow_Buffer *outBuffer, ARect *inOutDirtyBounds) {
+    window->buffer.resize(static_cast<size_t>(window->width) * static_cast<size_t>(window->height) * window->BytesPerPixel());
+
+    *outBuffer = ANativeWindow_Buffer{
+        .width = window->width,
+        .height = window->height,
+        .stride = window->width,
+        .format = window->format,
+        .bits = window->buffer.data(),
+    };
+    if (inOutDirtyBounds)
+        *inOutDirtyBounds = ARect{0, 0, window->width, window->height};
+    return 0;
+}
+
+int32_t ANativeWindow_unlockAndPost(ANativeWindow *window) {
+    if (window->dump.is_open())
+        window->dump.write(reinterpret_cast<const char *>(window->buffer.data()), static_cast<std::streamsize>(window->buffer.size()));
+    return 0;
+}
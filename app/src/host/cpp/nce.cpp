@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cerrno>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <nce/guest.h>
+#include <nce.h>
+
+namespace skyline {
+    namespace guest {
+        void GuestEntry(u64 address) {
+            throw exception("Guest code cannot be executed on a host build");
+        }
+    }
+
+    NCE::NCE(DeviceState &state) : state(state) {}
+
+    NCE::~NCE() = default;
+
+    void NCE::KernelThread(pid_t thread) {
+        throw exception("Guest threads cannot be run on a host build");
+    }
+
+    void NCE::Execute() {
+        throw exception("Guest code cannot be executed on a host build");
+    }
+
+    /**
+     * @note There's no guest process on a host build, the "guest" shares the address space of the host process so functions are run on the calling thread
+     */
+    void NCE::ExecuteFunction(ThreadCall call, Registers &funcRegs) {
+        switch (call) {
+            case ThreadCall::Syscall: {
+                auto result{syscall(static_cast<long>(funcRegs.x8), funcRegs.x0, funcRegs.x1, funcRegs.x2, funcRegs.x3, funcRegs.x4, funcRegs.x5)};
+                funcRegs.x0 = static_cast<u64>(result == -1 ? -errno : result); // The result is returned like a raw syscall would
+                break;
+            }
+
+            case ThreadCall::Memcopy:
+                std::memmove(reinterpret_cast<void *>(funcRegs.x1), reinterpret_cast<const void *>(funcRegs.x0), funcRegs.x2);
+                break;
+
+            default:
+                throw exception("Thread call {} isn't supported on a host build", static_cast<u32>(call));
+        }
+    }
+
+    void NCE::ExecuteFunction(ThreadCall call, Registers &funcRegs, std::shared_ptr<kernel::type::KThread> &thread) {
+        ExecuteFunction(call, funcRegs);
+    }
+
+    void NCE::WaitThreadInit(std::shared_ptr<kernel::type::KThread> &thread) {}
+
+    void NCE::StartThread(u64 entryArg, u32 handle, std::shared_ptr<kernel::type::KThread> &thread) {
+        throw exception("Guest threads cannot be started on a host build");
+    }
+
+    void NCE::ThreadTrace(u16 numHist, ThreadContext *ctx) {}
+
+    std::vector<u32> NCE::PatchCode(std::vector<u8> &code, u64 baseAddress, i64 offset) {
+        return {}; // Guest code is never executed on a host so it doesn't need to be patched
+    }
+}
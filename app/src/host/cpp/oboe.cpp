@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <vector>
+#include <chrono>
+#include <pthread.h>
+#include <oboe/Oboe.h>
+
+namespace oboe {
+    AudioStream::AudioStream(AudioStreamCallback *callback, int32_t channelCount, int32_t sampleRate, int32_t framesPerCallback) : callback(callback), channelCount(channelCount), sampleRate(sampleRate), framesPerCallback(framesPerCallback ? framesPerCallback : FramesPerBurst), bufferSize(FramesPerBurst * 2) {}
+
+    AudioStream::~AudioStream() {
+        requestStop();
+    }
+
+    void AudioStream::Run() {
+        pthread_setname_np(pthread_self(), "Skyline-Audio");
+
+        std::vector<int16_t> buffer(static_cast<size_t>(framesPerCallback) * static_cast<size_t>(channelCount));
+        std::chrono::nanoseconds period{std::chrono::seconds(framesPerCallback) / sampleRate};
+        auto deadline{std::chrono::steady_clock::now()};
+
+        while (running.load(std::memory_order_relaxed)) {
+            if (callback->onAudioReady(this, buffer.data(), framesPerCallback) == DataCallbackResult::Stop)
+                break;
+
+            deadline += period;
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+
+    Result AudioStream::requestStart() {
+        if (running.exchange(true))
+            return Result::ErrorInvalidState;
+
+        thread = std::thread(&AudioStream::Run, this);
+        return Result::OK;
+    }
+
+    Result AudioStream::requestStop() {
+        if (!running.exchange(false))
+            return Result::OK;
+
+        if (thread.get_id() == std::this_thread::get_id())
+            thread.detach(); // The stream was stopped from its own callback, the thread exits once it returns
+        else
+            thread.join();
+        return Result::OK;
+    }
+
+    Result AudioStreamBuilder::openManagedStream(ManagedStream &stream) {
+        stream = std::make_unique<AudioStream>(callback, channelCount, sampleRate, framesPerCallback);
+        return Result::OK;
+    }
+}
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gpu.h>
+#include "../environment.h"
+
+namespace skyline::replay {
+    using namespace gpu::capture;
+
+    /**
+     * @brief A single record of a capture alongside its payload
+     */
+    struct Record {
+        RecordType type;
+        std::vector<u8> payload;
+    };
+
+    /**
+     * @brief Reads all records from a capture file and validates their layout
+     */
+    std::vector<Record> ReadCapture(const std::string &path) {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+            throw exception("Failed to open the capture file: {}", path);
+
+        FileHeader header{};
+        if (!stream.read(reinterpret_cast<char *>(&header), sizeof(FileHeader)) || header.magic != Magic)
+            throw exception("The capture file has an invalid magic: {}", path);
+        if (header.version != Version)
+            throw exception("The capture file has version {} while version {} is supported", header.version, Version);
+
+        std::vector<Record> records;
+        RecordHeader recordHeader{};
+        while (stream.read(reinterpret_cast<char *>(&recordHeader), sizeof(RecordHeader))) {
+            auto &record{records.emplace_back(Record{recordHeader.type, std::vector<u8>(recordHeader.size)})};
+            if (!stream.read(reinterpret_cast<char *>(record.payload.data()), recordHeader.size))
+                throw exception("The capture file is truncated in record {}", records.size() - 1);
+
+            size_t minimumSize{};
+            switch (record.type) {
+                case RecordType::Map:
+                    minimumSize = sizeof(MapRecord);
+                    break;
+                case RecordType::Unmap:
+                    minimumSize = sizeof(u64);
+                    break;
+                case RecordType::Submission:
+                    minimumSize = sizeof(SubmissionRecord);
+                    break;
+                default:
+                    throw exception("The capture file has an unknown record type {} in record {}", static_cast<u32>(record.type), records.size() - 1);
+            }
+
+            if (record.payload.size() < minimumSize)
+                throw exception("Record {} is too small for its type: 0x{:X} bytes", records.size() - 1, record.payload.size());
+        }
+
+        return records;
+    }
+
+    /**
+     * @brief The Replayer class feeds the records of a capture through the GPU front-end, recreating the GPU address space with guest memory of its own
+     */
+    class Replayer {
+      private:
+        host::Environment &environment;
+        gpu::GPU &gpu;
+        std::map<u64, std::shared_ptr<kernel::type::KSharedMemory>> mappings; //!< The guest memory backing every mapped region of the GPU address space, keyed by GPU address
+        std::vector<gpu::gpfifo::GpEntry> entries; //!< A reused buffer which holds the GP entries of a submission
+
+        void Map(const MapRecord &record) {
+            auto memory{environment.AllocateGuest(record.size)};
+            if (!gpu.memoryManager.MapFixed(record.address, memory->guest.address, record.size))
+                throw exception("Failed to map 0x{:X} bytes at 0x{:X} in the GPU address space", record.size, record.address);
+            mappings[record.address] = std::move(memory);
+        }
+
+        void Unmap(u64 address) {
+            gpu.memoryManager.Unmap(address);
+            mappings.erase(address);
+        }
+
+        /**
+         * @brief Writes the captured pushbuffers into the GPU address space and processes the GP entries
+         * @return The time spent processing the GP entries, this excludes the writes which stand in for the guest filling the pushbuffers
+         */
+        std::chrono::nanoseconds Submit(std::span<const u8> payload) {
+            constexpr size_t EntryWords{sizeof(gpu::gpfifo::GpEntry) / sizeof(u32)};
+            auto words{std::span(reinterpret_cast<const u32 *>(payload.data()), payload.size() / sizeof(u32))};
+            auto entryCount{words[0]};
+            words = words.subspan(sizeof(SubmissionRecord) / sizeof(u32));
+
+            entries.clear();
+            for (u32 index{}; index < entryCount; index++) {
+                if (words.size() < EntryWords)
+                    throw exception("Submission is truncated at entry {}", index);
+
+                auto &entry{entries.emplace_back()};
+                std::memcpy(&entry, words.data(), sizeof(gpu::gpfifo::GpEntry));
+                words = words.subspan(EntryWords);
+
+                if (words.size() < entry.size)
+                    throw exception("Pushbuffer of entry {} is truncated", index);
+
+                if (entry.size) {
+                    gpu.memoryManager.Write(const_cast<u8 *>(reinterpret_cast<const u8 *>(words.data())), (static_cast<u64>(entry.getHi) << 32) | (static_cast<u64>(entry.get) << 2), entry.size * sizeof(u32));
+                    words = words.subspan(entry.size);
+                }
+
+                submittedWords += entry.size;
+            }
+            submittedEntries += entryCount;
+
+            auto start{std::chrono::steady_clock::now()};
+            gpu.gpfifo.Push(entries);
+            gpu.gpfifo.Run();
+            return std::chrono::steady_clock::now() - start;
+        }
+
+      public:
+        u64 submittedEntries{}; //!< The amount of GP entries that were processed
+        u64 submittedWords{}; //!< The amount of pushbuffer words that were processed
+
+        Replayer(host::Environment &environment) : environment(environment), gpu(*environment.state.gpu) {}
+
+        /**
+         * @brief Replays every record in a capture
+         * @return The time spent processing submissions
+         */
+        std::chrono::nanoseconds Replay(const std::vector<Record> &records) {
+            std::chrono::nanoseconds processingTime{};
+            for (const auto &record : records) {
+                switch (record.type) {
+                    case RecordType::Map:
+                        Map(*reinterpret_cast<const MapRecord *>(record.payload.data()));
+                        break;
+                    case RecordType::Unmap:
+                        Unmap(*reinterpret_cast<const u64 *>(record.payload.data()));
+                        break;
+                    case RecordType::Submission:
+                        processingTime += Submit(record.payload);
+                        break;
+                }
+            }
+            return processingTime;
+        }
+
+        /**
+         * @return A FNV-1a hash of the Maxwell 3D register space, two replays of the same capture must always result in the same hash
+         */
+        u64 HashRegisters() {
+            u64 hash{0xCBF29CE484222325};
+            for (auto value : gpu.maxwell3D->registers.raw) {
+                hash ^= value;
+                hash *= 0x100000001B3;
+            }
+            return hash;
+        }
+    };
+}
+
+/**
+ * @brief Replays a GPU capture through the GPU front-end with no guest running
+ * @note The result is printed as a single JSON object, the register hash can be compared across builds to detect changes in the behaviour of the command processor
+ */
+int main(int argc, char **argv) {
+    using namespace skyline;
+
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <capture> [--loops <count>]\n", argv[0]);
+        return 1;
+    }
+
+    std::string path{argv[1]};
+    u64 loops{1};
+    for (int index{2}; index < argc; index++) {
+        std::string_view argument{argv[index]};
+        if (argument == "--loops" && index + 1 < argc)
+            loops = std::max<u64>(std::strtoull(argv[++index], nullptr, 10), 1);
+    }
+
+    try {
+        auto records{replay::ReadCapture(path)};
+
+        host::Environment environment;
+        replay::Replayer replayer(environment);
+
+        std::chrono::nanoseconds processingTime{};
+        for (u64 loop{}; loop < loops; loop++)
+            processingTime += replayer.Replay(records);
+
+        auto seconds{std::chrono::duration<double>(processingTime).count()};
+        fmt::print(R"({{"capture":"{}","records":{},"loops":{},"entries":{},"words":{},"filtered_writes":{},"ns_per_loop":{:.0f},"words_per_second":{:.0f},"register_hash":"0x{:016X}"}})" "\n",
+                   path, records.size(), loops, replayer.submittedEntries, replayer.submittedWords, environment.state.gpu->maxwell3D->filteredMethodCount, static_cast<double>(processingTime.count()) / static_cast<double>(loops), static_cast<double>(replayer.submittedWords) / seconds, replayer.HashRegisters());
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "Replay failed: %s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <android/sharedmem.h>
+
+int ASharedMemory_create(const char *name, size_t size) {
+    int fd{memfd_create(name, MFD_CLOEXEC)};
+    if (fd < 0)
+        return -errno;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        int error{errno};
+        close(fd);
+        return -error;
+    }
+
+    return fd;
+}
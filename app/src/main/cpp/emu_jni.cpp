@@ -8,6 +8,7 @@
 #include "skyline/os.h"
 #include "skyline/jvm.h"
 #include "skyline/input.h"
+#include "skyline/audio.h"
 
 bool Halt;
 jobject Surface;
@@ -16,6 +17,7 @@ skyline::GroupMutex JniMtx;
 skyline::u16 fps;
 skyline::u32 frametime;
 std::weak_ptr<skyline::input::Input> inputWeak;
+std::weak_ptr<skyline::audio::Audio> audioWeak;
 
 void signalHandler(int signal) {
     syslog(LOG_ERR, "Halting program due to signal: %s", strsignal(signal));
@@ -26,7 +28,7 @@ void signalHandler(int signal) {
     FaultCount++;
 }
 
-extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_executeApplication(JNIEnv *env, jobject instance, jstring romUriJstring, jint romType, jint romFd, jint preferenceFd, jstring appFilesPathJstring) {
+extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_executeApplication(JNIEnv *env, jobject instance, jstring romUriJstring, jint romType, jint romFd, jint updateFd, jint preferenceFd, jstring appFilesPathJstring) {
     Halt = false;
     FaultCount = 0;
     fps = 0;
@@ -53,6 +55,7 @@ extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_executeApplication(
     try {
         skyline::kernel::OS os(jvmManager, logger, settings, std::string(appFilesPath));
         inputWeak = os.state.input;
+        audioWeak = os.state.audio;
         jvmManager->InitializeControllers();
         env->ReleaseStringUTFChars(appFilesPathJstring, appFilesPath);
 
@@ -60,7 +63,7 @@ extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_executeApplication(
         logger->Info("Launching ROM {}", romUri);
         env->ReleaseStringUTFChars(romUriJstring, romUri);
 
-        os.Execute(romFd, static_cast<skyline::loader::RomFormat>(romType));
+        os.Execute(romFd, static_cast<skyline::loader::RomFormat>(romType), updateFd);
     } catch (std::exception &e) {
         logger->Error(e.what());
     } catch (...) {
@@ -68,6 +71,7 @@ extern "C" JNIEXPORT void Java_emu_skyline_EmulationActivity_executeApplication(
     }
 
     inputWeak.reset();
+    audioWeak.reset();
 
     logger->Info("Emulation has ended");
 
@@ -100,6 +104,32 @@ extern "C" JNIEXPORT jfloat Java_emu_skyline_EmulationActivity_getFrametime(JNIE
     return static_cast<float>(frametime) / 100;
 }
 
+extern "C" JNIEXPORT jlongArray JNICALL Java_emu_skyline_EmulationActivity_getAudioStatistics(JNIEnv *env, jobject) {
+    auto audio{audioWeak.lock()};
+    if (!audio)
+        return nullptr;
+
+    auto statistics{audio->GetStatistics()};
+    std::array<jlong, 12> values{
+        static_cast<jlong>(statistics.callbackCount),
+        static_cast<jlong>(statistics.underrunCount),
+        static_cast<jlong>(statistics.xrunCount),
+        static_cast<jlong>(statistics.callbackDuration.Mean()),
+        static_cast<jlong>(statistics.callbackDuration.Percentile(99)),
+        static_cast<jlong>(statistics.callbackDuration.max),
+        static_cast<jlong>(statistics.callbackInterval.Percentile(99)),
+        static_cast<jlong>(statistics.ringFill.Mean()),
+        static_cast<jlong>(statistics.ringFill.Percentile(1)),
+        static_cast<jlong>(statistics.latency.Mean()),
+        static_cast<jlong>(statistics.latency.Percentile(99)),
+        static_cast<jlong>(statistics.latency.max),
+    };
+
+    auto array{env->NewLongArray(values.size())};
+    env->SetLongArrayRegion(array, 0, values.size(), values.data());
+    return array;
+}
+
 extern "C" JNIEXPORT void JNICALL Java_emu_skyline_EmulationActivity_setController(JNIEnv *, jobject, jint index, jint type, jint partnerIndex) {
     auto input = inputWeak.lock();
     std::lock_guard guard(input->npad.mutex);
@@ -15,11 +15,12 @@ extern "C" JNIEXPORT jint JNICALL Java_emu_skyline_loader_RomFile_populate(JNIEn
 
     auto appFilesPath{env->GetStringUTFChars(appFilesPathJstring, nullptr)};
     auto keyStore{std::make_shared<skyline::crypto::KeyStore>(appFilesPath)};
+    std::string cachePath{std::string(appFilesPath) + "/romfs_index"};
     env->ReleaseStringUTFChars(appFilesPathJstring, appFilesPath);
 
     std::unique_ptr<skyline::loader::Loader> loader;
     try {
-        auto backing{std::make_shared<skyline::vfs::OsBacking>(fd)};
+        auto backing{std::make_shared<skyline::vfs::OsBacking>(fd, false, skyline::vfs::Backing::Mode{true, false, false}, true)};
 
         switch (format) {
             case skyline::loader::RomFormat::NRO:
@@ -32,7 +33,7 @@ extern "C" JNIEXPORT jint JNICALL Java_emu_skyline_loader_RomFile_populate(JNIEn
                 loader = std::make_unique<skyline::loader::NcaLoader>(backing, keyStore);
                 break;
             case skyline::loader::RomFormat::NSP:
-                loader = std::make_unique<skyline::loader::NspLoader>(backing, keyStore);
+                loader = std::make_unique<skyline::loader::NspLoader>(backing, keyStore, cachePath);
                 break;
             default:
                 return static_cast<jint>(skyline::loader::LoaderResult::ParsingError);
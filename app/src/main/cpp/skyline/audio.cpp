@@ -4,18 +4,86 @@
 #include "audio.h"
 
 namespace skyline::audio {
-    Audio::Audio(const DeviceState &state) : oboe::AudioStreamCallback() {
+    Audio::Audio(const DeviceState &state) : oboe::AudioStreamCallback(), state(state) {
+        constexpr std::array<oboe::PerformanceMode, 3> PerformanceModes{oboe::PerformanceMode::None, oboe::PerformanceMode::PowerSaving, oboe::PerformanceMode::LowLatency}; //!< The oboe performance modes corresponding to the values of the performance mode setting
+        constexpr int DefaultPerformanceMode{2}; //!< Low latency, this is the default value in the preferences
+        constexpr int DefaultBufferBursts{0}; //!< The buffer size is left to oboe by default
+
+        // ListPreference values are stored as strings, these might be missing on installs from before the settings were added
+        auto getIntSetting{[&](const std::string &key, int fallback) {
+            try {
+                return std::stoi(state.settings->GetString(key, std::to_string(fallback)));
+            } catch (const std::logic_error &) {
+                state.logger->Warn("Audio setting {} has a malformed value, using the default: {}", key, fallback);
+                return fallback;
+            }
+        }};
+
+        auto performanceMode{getIntSetting("audio_performance_mode", DefaultPerformanceMode)};
+        if (performanceMode < 0 || performanceMode >= static_cast<int>(PerformanceModes.size()))
+            performanceMode = DefaultPerformanceMode;
+        bufferBursts = static_cast<u32>(std::max(getIntSetting("audio_buffer_bursts", DefaultBufferBursts), 0));
+
         builder.setChannelCount(constant::ChannelCount);
         builder.setSampleRate(constant::SampleRate);
         builder.setFormat(constant::PcmFormat);
-        builder.setFramesPerCallback(constant::MixBufferSize);
+        builder.setPerformanceMode(PerformanceModes[static_cast<size_t>(performanceMode)]);
+        // Smaller buffers are only beneficial if the callback is invoked for every burst, so the callback size is left to oboe in that case
+        if (!bufferBursts)
+            builder.setFramesPerCallback(constant::MixBufferSize);
         builder.setUsage(oboe::Usage::Game);
         builder.setCallback(this);
 
+        OpenStream();
+    }
+
+    void Audio::OpenStream() {
         builder.openManagedStream(outputStream);
+
+        if (bufferBursts) {
+            auto result{outputStream->setBufferSizeInFrames(outputStream->getFramesPerBurst() * static_cast<i32>(bufferBursts))};
+            if (result)
+                state.logger->Debug("Audio stream buffer size: {} frames ({} bursts)", result.value(), bufferBursts);
+        }
+
         outputStream->requestStart();
     }
 
+    i32 Audio::GetXRunCount() {
+        auto result{outputStream->getXRunCount()};
+        return result ? result.value() : 0;
+    }
+
+    AudioStatistics Audio::GetStatistics() {
+        AudioStatistics statistics{
+            .callbackDuration = callbackDuration.Snapshot(),
+            .callbackInterval = callbackInterval.Snapshot(),
+            .ringFill = ringFill.Snapshot(),
+            .underrunCount = underrunCount.load(std::memory_order_relaxed),
+            .xrunCount = GetXRunCount(),
+        };
+        statistics.callbackCount = statistics.callbackDuration.count;
+
+        std::lock_guard trackGuard(trackLock);
+        statistics.latency = closedLatency;
+        for (auto &track : audioTracks)
+            statistics.latency.Merge(track->latency.Snapshot());
+
+        return statistics;
+    }
+
+    void Audio::ResetStatistics() {
+        callbackDuration.Reset();
+        callbackInterval.Reset();
+        ringFill.Reset();
+        underrunCount.store(0, std::memory_order_relaxed);
+
+        std::lock_guard trackGuard(trackLock);
+        closedLatency = {};
+        for (auto &track : audioTracks)
+            track->latency.Reset();
+    }
+
     std::shared_ptr<AudioTrack> Audio::OpenTrack(u8 channelCount, u32 sampleRate, const std::function<void()> &releaseCallback) {
         std::lock_guard trackGuard(trackLock);
 
@@ -28,14 +96,24 @@ namespace skyline::audio {
     void Audio::CloseTrack(std::shared_ptr<AudioTrack> &track) {
         std::lock_guard trackGuard(trackLock);
 
+        if (track->underrunCount)
+            state.logger->Debug("Closing audio track with {} underruns, {} stream xruns in total", track->underrunCount, GetXRunCount());
+        closedLatency.Merge(track->latency.Snapshot());
+
         audioTracks.erase(std::remove(audioTracks.begin(), audioTracks.end(), track), audioTracks.end());
         track.reset();
     }
 
     oboe::DataCallbackResult Audio::onAudioReady(oboe::AudioStream *audioStream, void *audioData, int32_t numFrames) {
+        auto startTime{util::GetTimeNs()};
+        auto previousTime{lastCallbackTime.exchange(startTime, std::memory_order_relaxed)};
+        if (previousTime)
+            callbackInterval.Record(startTime - previousTime);
+
         auto destBuffer{static_cast<i16 *>(audioData)};
         auto streamSamples{static_cast<size_t>(numFrames) * audioStream->getChannelCount()};
         size_t writtenSamples{};
+        bool underrun{};
 
         {
             std::lock_guard trackGuard(trackLock);
@@ -46,12 +124,19 @@ namespace skyline::audio {
 
                 std::lock_guard bufferGuard(track->bufferLock);
 
+                bool pending{track->HasPendingBuffers()};
+                ringFill.Record(track->GetQueuedFrames());
                 auto trackSamples = track->samples.Read(destBuffer, streamSamples, [](i16 *source, i16 *destination) {
                     *destination = Saturate<i16, i32>(static_cast<u32>(*destination) + static_cast<u32>(*source));
                 }, writtenSamples);
 
                 writtenSamples = std::max(trackSamples, writtenSamples);
 
+                if (pending && trackSamples < streamSamples) {
+                    track->underrunCount++;
+                    underrun = true;
+                }
+
                 track->sampleCounter += trackSamples;
                 track->CheckReleasedBuffers();
             }
@@ -60,13 +145,16 @@ namespace skyline::audio {
         if (streamSamples > writtenSamples)
             memset(destBuffer + writtenSamples, 0, (streamSamples - writtenSamples) * sizeof(i16));
 
+        if (underrun)
+            underrunCount.fetch_add(1, std::memory_order_relaxed);
+
+        callbackDuration.Record(util::GetTimeNs() - startTime);
+
         return oboe::DataCallbackResult::Continue;
     }
 
     void Audio::onErrorAfterClose(oboe::AudioStream *audioStream, oboe::Result error) {
-        if (error == oboe::Result::ErrorDisconnected) {
-            builder.openManagedStream(outputStream);
-            outputStream->requestStart();
-        }
+        if (error == oboe::Result::ErrorDisconnected)
+            OpenStream();
     }
 }
@@ -8,6 +8,7 @@
 
 #include <kernel/types/KEvent.h>
 #include <audio/track.h>
+#include <audio/statistics.h>
 #include "common.h"
 
 namespace skyline::audio {
@@ -16,14 +17,50 @@ namespace skyline::audio {
      */
     class Audio : public oboe::AudioStreamCallback {
       private:
+        const DeviceState &state;
         oboe::AudioStreamBuilder builder; //!< The audio stream builder, used to open
         oboe::ManagedStream outputStream; //!< The output oboe audio stream
         std::vector<std::shared_ptr<AudioTrack>> audioTracks; //!< A vector of shared_ptr to every open audio track
         Mutex trackLock; //!< This mutex is used to ensure that audioTracks isn't modified while it is being used
+        u32 bufferBursts{}; //!< The size of the stream buffer in bursts, zero if the default size should be used
+        std::atomic<u64> underrunCount{}; //!< The amount of callbacks in which a playing track couldn't provide all requested samples
+        std::atomic<u64> lastCallbackTime{}; //!< The time at which the previous callback started in nanoseconds
+        Histogram callbackDuration; //!< The time spent in the output callback in nanoseconds
+        Histogram callbackInterval; //!< The time between the starts of consecutive output callbacks in nanoseconds
+        Histogram ringFill; //!< The amount of frames queued in a playing track at the start of a callback
+        HistogramSnapshot closedLatency; //!< The latency histograms of all closed tracks merged together, this is protected by trackLock
+
+        /**
+         * @brief Opens and starts the output stream, applying the buffer size if one was specified
+         */
+        void OpenStream();
 
       public:
         Audio(const DeviceState &state);
 
+        /**
+         * @return The amount of callbacks in which a playing track couldn't provide all requested samples
+         */
+        inline u64 GetUnderrunCount() {
+            return underrunCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return The amount of underruns and overruns reported by the output stream, this includes those caused by the callback not returning in time
+         */
+        i32 GetXRunCount();
+
+        /**
+         * @return A snapshot of the statistics of the output stream and all tracks, these are accumulated from the creation of this object or the last call to ResetStatistics
+         * @note This doesn't block the output callback for longer than it takes to copy the latency histograms of the open tracks
+         */
+        AudioStatistics GetStatistics();
+
+        /**
+         * @brief Clears all accumulated statistics aside from the stream xrun count which is maintained by the audio driver
+         */
+        void ResetStatistics();
+
         /**
          * @brief Opens a new track that can be used to play sound
          * @param channelCount The amount channels that are present in the track
@@ -43,6 +43,7 @@ namespace skyline {
         struct BufferIdentifier {
             u64 tag;
             u64 finalSample; //!< The final sample this buffer will be played in, after that the buffer can be safely released
+            u64 appendTime; //!< The time at which the buffer was appended in nanoseconds
             bool released; //!< If the buffer has been released (fully played back)
         };
 
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cmath>
+#include "effects.h"
+
+namespace skyline::audio {
+    void DelayLine::Resize(size_t capacity) {
+        buffer.assign(capacity, 0.0f);
+        position = 0;
+    }
+
+    void DelayLine::Clear() {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        position = 0;
+    }
+
+    void DelayLine::Read(std::span<float> output, size_t delay) const {
+        auto start{(position + buffer.size() - delay) % buffer.size()};
+        auto firstSize{std::min(output.size(), buffer.size() - start)};
+
+        std::memcpy(output.data(), buffer.data() + start, firstSize * sizeof(float));
+        std::memcpy(output.data() + firstSize, buffer.data(), (output.size() - firstSize) * sizeof(float));
+    }
+
+    void DelayLine::ReadAccumulate(std::span<float> output, size_t delay, float gain) const {
+        auto start{(position + buffer.size() - delay) % buffer.size()};
+        auto firstSize{std::min(output.size(), buffer.size() - start)};
+
+        auto source{buffer.data() + start};
+        for (size_t index{}; index < firstSize; index++)
+            output[index] += source[index] * gain;
+
+        auto wrapped{output.data() + firstSize};
+        for (size_t index{}; index < output.size() - firstSize; index++)
+            wrapped[index] += buffer[index] * gain;
+    }
+
+    void DelayLine::Write(std::span<const float> input) {
+        auto firstSize{std::min(input.size(), buffer.size() - position)};
+
+        std::memcpy(buffer.data() + position, input.data(), firstSize * sizeof(float));
+        std::memcpy(buffer.data(), input.data() + firstSize, (input.size() - firstSize) * sizeof(float));
+
+        position = (position + input.size()) % buffer.size();
+    }
+
+    void DelayEffect::Configure(const Parameters &newParameters, u32 sampleRate) {
+        auto capacity{std::max(static_cast<size_t>(static_cast<u64>(newParameters.delayTimeMax) * sampleRate / 1000), static_cast<size_t>(1))};
+        if (capacity != lines.front().Capacity()) {
+            for (auto &line : lines)
+                line.Resize(capacity);
+            lowpassState.fill(0.0f);
+        }
+
+        parameters = newParameters;
+        delaySamples = std::clamp(static_cast<size_t>(static_cast<u64>(parameters.delayTime) * sampleRate / 1000), static_cast<size_t>(1), capacity);
+    }
+
+    void DelayEffect::Reset() {
+        for (auto &line : lines)
+            line.Clear();
+        lowpassState.fill(0.0f);
+    }
+
+    void DelayEffect::Process(std::span<const std::span<float>> inputs, std::span<const std::span<float>> outputs) {
+        auto channelCount{std::min(inputs.size(), lines.size())};
+        if (!channelCount || !lines.front().Capacity())
+            return;
+
+        auto frameCount{inputs.front().size()};
+        auto spread{channelCount == 2 ? std::clamp(parameters.channelSpread, 0.0f, 1.0f) : 0.0f};
+        auto lowpassCoefficient{1.0f - std::clamp(parameters.lowpassAmount, 0.0f, 0.95f)};
+
+        for (size_t offset{}; offset < frameCount;) {
+            // The block can't be longer than the delay as it would otherwise depend on its own feedback
+            auto blockSize{std::min({frameCount - offset, delaySamples, static_cast<size_t>(constant::EffectBlockSize)})};
+
+            for (size_t channel{}; channel < channelCount; channel++) {
+                std::memcpy(input[channel].data(), inputs[channel].data() + offset, blockSize * sizeof(float));
+                lines[channel].Read(std::span(delayed[channel].data(), blockSize), delaySamples);
+            }
+
+            for (size_t channel{}; channel < channelCount; channel++) {
+                auto &other{delayed[channelCount - channel - 1]};
+                for (size_t index{}; index < blockSize; index++)
+                    feedback[channel][index] = delayed[channel][index] * (1.0f - spread) + other[index] * spread;
+            }
+
+            for (size_t channel{}; channel < channelCount; channel++) {
+                auto state{lowpassState[channel]};
+                for (size_t index{}; index < blockSize; index++) {
+                    state += (feedback[channel][index] - state) * lowpassCoefficient;
+                    feedback[channel][index] = input[channel][index] * parameters.inGain + state * parameters.feedbackGain;
+                }
+                lowpassState[channel] = state;
+
+                lines[channel].Write(std::span<const float>(feedback[channel].data(), blockSize));
+
+                auto output{outputs[channel].data() + offset};
+                for (size_t index{}; index < blockSize; index++)
+                    output[index] = input[channel][index] * parameters.dryGain + delayed[channel][index] * parameters.wetGain;
+            }
+
+            offset += blockSize;
+        }
+    }
+
+    void ReverbEffect::Configure(const Parameters &newParameters, u32 newSampleRate) {
+        if (sampleRate != newSampleRate) {
+            sampleRate = newSampleRate;
+
+            preDelayLine.Resize(static_cast<size_t>((MaxDelay + EarlyTapTimes.back() * MaxEarlyScale) * sampleRate) + constant::EffectBlockSize + 1);
+            for (size_t line{}; line < LineCount; line++)
+                lines[line].Resize(std::max(static_cast<size_t>(LineLengths[line] * MaxLateScale * sampleRate / constant::SampleRate), static_cast<size_t>(constant::EffectBlockSize)));
+            dampingState.fill(0.0f);
+        }
+
+        parameters = newParameters;
+
+        preDelaySamples = static_cast<size_t>(std::clamp(parameters.preDelay, 0.0f, MaxDelay) * sampleRate);
+        lateDelaySamples = static_cast<size_t>(std::clamp(parameters.lateDelay, 0.0f, MaxDelay) * sampleRate);
+
+        auto earlyScale{std::clamp(parameters.earlyScale, 0.0f, MaxEarlyScale)};
+        for (size_t tap{}; tap < EarlyTapCount; tap++)
+            earlyTaps[tap] = preDelaySamples + static_cast<size_t>(EarlyTapTimes[tap] * earlyScale * sampleRate);
+
+        auto lateScale{std::clamp(parameters.lateScale, 0.25f, MaxLateScale)};
+        for (size_t line{}; line < LineCount; line++) {
+            lineDelays[line] = std::clamp(static_cast<size_t>(LineLengths[line] * lateScale * sampleRate / constant::SampleRate), static_cast<size_t>(constant::EffectBlockSize), lines[line].Capacity());
+            lineGains[line] = (parameters.decayTime > 0.0f) ? std::pow(10.0f, -3.0f * static_cast<float>(lineDelays[line]) / (parameters.decayTime * static_cast<float>(sampleRate))) : 0.0f;
+        }
+    }
+
+    void ReverbEffect::Reset() {
+        preDelayLine.Clear();
+        for (auto &line : lines)
+            line.Clear();
+        dampingState.fill(0.0f);
+    }
+
+    void ReverbEffect::Process(std::span<const std::span<float>> inputs, std::span<const std::span<float>> outputs) {
+        auto channelCount{std::min(inputs.size(), input.size())};
+        if (!channelCount || !sampleRate)
+            return;
+
+        auto frameCount{inputs.front().size()};
+        auto inputScale{parameters.inGain / static_cast<float>(channelCount)};
+        auto dampingCoefficient{1.0f - std::clamp(parameters.damping, 0.0f, 0.95f)};
+        auto lateGain{parameters.lateGain * 0.5f};
+
+        for (size_t offset{}; offset < frameCount;) {
+            auto blockSize{std::min(frameCount - offset, static_cast<size_t>(constant::EffectBlockSize))};
+
+            std::fill_n(mono.begin(), blockSize, 0.0f);
+            for (size_t channel{}; channel < channelCount; channel++) {
+                std::memcpy(input[channel].data(), inputs[channel].data() + offset, blockSize * sizeof(float));
+                for (size_t index{}; index < blockSize; index++)
+                    mono[index] += input[channel][index] * inputScale;
+            }
+
+            // The mono signal is written prior to being tapped, so the pre-delay and the taps may be shorter than the block
+            preDelayLine.Write(std::span<const float>(mono.data(), blockSize));
+
+            for (auto &channel : wet)
+                std::fill_n(channel.begin(), blockSize, 0.0f);
+            for (size_t tap{}; tap < EarlyTapCount; tap++)
+                preDelayLine.ReadAccumulate(std::span(wet[tap % 2].data(), blockSize), earlyTaps[tap] + blockSize, EarlyTapGains[tap] * parameters.earlyGain);
+            preDelayLine.Read(std::span(lateInput.data(), blockSize), lateDelaySamples + blockSize);
+
+            // Every line of the feedback delay network is at least a block long, so this block only depends on previous ones
+            for (size_t line{}; line < LineCount; line++) {
+                lines[line].Read(std::span(lineOutputs[line].data(), blockSize), lineDelays[line]);
+
+                auto state{dampingState[line]};
+                for (size_t index{}; index < blockSize; index++) {
+                    state += (lineOutputs[line][index] - state) * dampingCoefficient;
+                    lineOutputs[line][index] = state * lineGains[line];
+                }
+                dampingState[line] = state;
+            }
+
+            for (size_t index{}; index < blockSize; index++) {
+                wet[0][index] += (lineOutputs[0][index] + lineOutputs[2][index]) * lateGain;
+                wet[1][index] += (lineOutputs[1][index] + lineOutputs[3][index]) * lateGain;
+            }
+
+            // The lines are mixed using a normalized 4x4 Hadamard matrix, as it's orthogonal the network is lossless aside from the line gains
+            constexpr std::array<std::array<float, LineCount>, LineCount> FeedbackMatrix{{
+                {0.5f, 0.5f, 0.5f, 0.5f},
+                {0.5f, -0.5f, 0.5f, -0.5f},
+                {0.5f, 0.5f, -0.5f, -0.5f},
+                {0.5f, -0.5f, -0.5f, 0.5f},
+            }};
+
+            for (size_t line{}; line < LineCount; line++) {
+                auto &row{FeedbackMatrix[line]};
+                for (size_t index{}; index < blockSize; index++)
+                    mono[index] = lateInput[index] + lineOutputs[0][index] * row[0] + lineOutputs[1][index] * row[1] + lineOutputs[2][index] * row[2] + lineOutputs[3][index] * row[3];
+                lines[line].Write(std::span<const float>(mono.data(), blockSize));
+            }
+
+            for (size_t channel{}; channel < channelCount; channel++) {
+                auto &channelWet{wet[channel % wet.size()]};
+                auto output{outputs[channel].data() + offset};
+                for (size_t index{}; index < blockSize; index++)
+                    output[index] = input[channel][index] * parameters.dryGain + channelWet[index] * parameters.wetGain;
+            }
+
+            offset += blockSize;
+        }
+    }
+}
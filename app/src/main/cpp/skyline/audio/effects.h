@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <common.h>
+#include "common.h"
+
+namespace skyline {
+    namespace constant {
+        constexpr u32 EffectBlockSize{64}; //!< The amount of frames that effects process at once, all feedback delay lines are at least this long so a block never depends on its own output
+        constexpr u8 EffectMaxChannels{ChannelCount}; //!< The maximum amount of channels a single effect can process
+    }
+
+    namespace audio {
+        /**
+         * @brief The DelayLine class is a circular buffer of samples with preallocated storage, it's used to delay a signal by a variable amount of samples
+         * @note Allocations only happen in Resize, which should never be called from the mixing path
+         */
+        class DelayLine {
+          private:
+            std::vector<float> buffer; //!< The backing storage of the delay line
+            size_t position{}; //!< The index at which the next sample will be written
+
+          public:
+            /**
+             * @brief Resizes the delay line to hold the specified amount of samples and clears it
+             * @param capacity The maximum delay of the line in samples
+             */
+            void Resize(size_t capacity);
+
+            /**
+             * @brief Zeroes all samples in the delay line
+             */
+            void Clear();
+
+            /**
+             * @return The maximum delay of the line in samples
+             */
+            inline size_t Capacity() const {
+                return buffer.size();
+            }
+
+            /**
+             * @brief Reads a block of samples that were written a certain amount of samples before the current position
+             * @param output The buffer to read samples into
+             * @param delay The delay of the first sample to read, this must be at least output.size() if the block hasn't been written yet
+             */
+            void Read(std::span<float> output, size_t delay) const;
+
+            /**
+             * @brief Reads a block of samples and accumulates them into the output after scaling them
+             * @param output The buffer to add samples into
+             * @param delay The delay of the first sample to read
+             * @param gain The gain to apply to the read samples
+             */
+            void ReadAccumulate(std::span<float> output, size_t delay, float gain) const;
+
+            /**
+             * @brief Writes a block of samples at the current position and advances it
+             * @param input The samples to write
+             */
+            void Write(std::span<const float> input);
+        };
+
+        /**
+         * @brief The DelayEffect class implements a feedback delay with a lowpass filter in the feedback path and stereo channel spread
+         */
+        class DelayEffect {
+          public:
+            /**
+             * @brief The host representation of the delay parameters
+             */
+            struct Parameters {
+                u32 delayTimeMax; //!< The maximum delay time in milliseconds, this determines the size of the delay lines
+                u32 delayTime; //!< The delay time in milliseconds
+                float inGain;
+                float feedbackGain;
+                float wetGain;
+                float dryGain;
+                float channelSpread; //!< The amount of feedback that crosses over to the other channel
+                float lowpassAmount; //!< The amount of high frequency attenuation in the feedback path
+            };
+
+          private:
+            Parameters parameters{};
+            size_t delaySamples{1}; //!< The current delay in samples
+            std::array<DelayLine, constant::EffectMaxChannels> lines;
+            std::array<float, constant::EffectMaxChannels> lowpassState{}; //!< The state of the one-pole lowpass filter for every channel
+            std::array<std::array<float, constant::EffectBlockSize>, constant::EffectMaxChannels> delayed{}; //!< The delayed samples of the current block
+            std::array<std::array<float, constant::EffectBlockSize>, constant::EffectMaxChannels> feedback{}; //!< The feedback samples of the current block
+            std::array<std::array<float, constant::EffectBlockSize>, constant::EffectMaxChannels> input{}; //!< A copy of the input of the current block, this allows processing in-place
+
+          public:
+            /**
+             * @brief Applies new parameters, the delay lines are only reallocated when the maximum delay time changes
+             * @param sampleRate The sample rate of the processed signal
+             */
+            void Configure(const Parameters &newParameters, u32 sampleRate);
+
+            /**
+             * @brief Clears the internal state of the effect
+             */
+            void Reset();
+
+            /**
+             * @brief Processes a buffer of planar samples, the input and output channels may alias
+             * @param inputs The input samples for every channel
+             * @param outputs The output samples for every channel, this must be of the same size as inputs
+             */
+            void Process(std::span<const std::span<float>> inputs, std::span<const std::span<float>> outputs);
+        };
+
+        /**
+         * @brief The ReverbEffect class implements a reverb with tapped early reflections and a feedback delay network for late reverberation
+         * @note This is used for both the standard reverb and the I3DL2 reverb as they only differ in how they're parameterized
+         */
+        class ReverbEffect {
+          public:
+            /**
+             * @brief The host representation of the reverb parameters
+             */
+            struct Parameters {
+                float preDelay; //!< The delay before the early reflections in seconds
+                float lateDelay; //!< The delay before the late reverberation in seconds
+                float earlyScale; //!< A factor that is applied to the early reflection tap times
+                float lateScale; //!< A factor that is applied to the lengths of the late reverberation delay lines
+                float decayTime; //!< The time it takes for the late reverberation to decay by 60 dB in seconds
+                float damping; //!< The amount of high frequency attenuation in the late reverberation, from 0 to 1
+                float inGain;
+                float earlyGain;
+                float lateGain;
+                float wetGain;
+                float dryGain;
+            };
+
+          private:
+            static constexpr size_t LineCount{4}; //!< The amount of delay lines in the feedback delay network
+            static constexpr std::array<u32, LineCount> LineLengths{1117, 1361, 1571, 1811}; //!< The lengths of the feedback delay lines at a scale of 1 and 48 kHz, these are coprime to avoid coinciding echoes
+            static constexpr float MaxLateScale{2.0f}; //!< The maximum value of Parameters::lateScale
+            static constexpr float MaxDelay{0.5f}; //!< The maximum pre-delay and late delay in seconds
+            static constexpr size_t EarlyTapCount{8}; //!< The amount of early reflection taps
+            static constexpr std::array<float, EarlyTapCount> EarlyTapTimes{0.0043f, 0.0075f, 0.0109f, 0.0135f, 0.0182f, 0.0217f, 0.0264f, 0.0301f}; //!< The times of early reflections at a scale of 1 in seconds, even taps go to the left channel and odd taps go to the right channel
+            static constexpr std::array<float, EarlyTapCount> EarlyTapGains{0.84f, 0.72f, 0.63f, 0.56f, 0.47f, 0.41f, 0.34f, 0.29f}; //!< The gains of the early reflections
+            static constexpr float MaxEarlyScale{2.0f}; //!< The maximum value of Parameters::earlyScale
+
+            Parameters parameters{};
+            u32 sampleRate{};
+            size_t preDelaySamples{};
+            size_t lateDelaySamples{};
+            std::array<size_t, EarlyTapCount> earlyTaps{}; //!< The delay of every early reflection tap in samples, relative to the pre-delay
+            DelayLine preDelayLine; //!< The delay line for the mono input signal, early reflections and the late input are tapped from this
+            std::array<DelayLine, LineCount> lines; //!< The delay lines of the feedback delay network
+            std::array<size_t, LineCount> lineDelays{}; //!< The delay of every line of the feedback delay network in samples
+            std::array<float, LineCount> lineGains{}; //!< The gain applied to every line to achieve the decay time
+            std::array<float, LineCount> dampingState{}; //!< The state of the one-pole lowpass filter for every line
+            std::array<float, constant::EffectBlockSize> mono{}; //!< The mono downmix of the input for the current block
+            std::array<float, constant::EffectBlockSize> lateInput{}; //!< The pre-delayed input of the feedback delay network for the current block
+            std::array<std::array<float, constant::EffectBlockSize>, LineCount> lineOutputs{}; //!< The output of every line of the feedback delay network for the current block
+            std::array<std::array<float, constant::EffectBlockSize>, 2> wet{}; //!< The wet stereo output of the current block
+            std::array<std::array<float, constant::EffectBlockSize>, constant::EffectMaxChannels> input{}; //!< A copy of the input of the current block, this allows processing in-place
+
+          public:
+            /**
+             * @brief Applies new parameters, the delay lines are only allocated on the first call or if the sample rate changes
+             * @param sampleRate The sample rate of the processed signal
+             */
+            void Configure(const Parameters &newParameters, u32 sampleRate);
+
+            /**
+             * @brief Clears the internal state of the effect
+             */
+            void Reset();
+
+            /**
+             * @brief Processes a buffer of planar samples, the input and output channels may alias
+             * @param inputs The input samples for every channel
+             * @param outputs The output samples for every channel, this must be of the same size as inputs
+             */
+            void Process(std::span<const std::span<float>> inputs, std::span<const std::span<float>> outputs);
+        };
+    }
+}
@@ -122,9 +122,18 @@ namespace skyline::audio {
     // @fmt:on
 
     std::vector<i16> Resampler::ResampleBuffer(std::span<i16> inputBuffer, double ratio, u8 channelCount) {
+        std::vector<i16> outputBuffer;
+        ResampleBuffer(inputBuffer, ratio, channelCount, outputBuffer);
+        return outputBuffer;
+    }
+
+    void Resampler::ResampleBuffer(std::span<const i16> inputBuffer, double ratio, u8 channelCount, std::vector<i16> &outputBuffer) {
         auto step{static_cast<u32>(ratio * 0x8000)};
-        auto outputSize{static_cast<size_t>(inputBuffer.size() / ratio)};
-        std::vector<i16> outputBuffer(outputSize);
+        auto inputFrames{inputBuffer.size() / channelCount};
+        auto outputSize{static_cast<size_t>(inputFrames / ratio) * channelCount};
+        outputBuffer.resize(outputSize);
+        if (!inputFrames)
+            return;
 
         const std::array<LutEntry, 128> &lut = [step] {
             if (step > 0xAAAA)
@@ -135,14 +144,17 @@ namespace skyline::audio {
                 return CurveLut2;
         }();
 
+        auto lastFrame{inputFrames - 1};
         for (size_t outIndex{}, inIndex{}; outIndex < outputSize; outIndex += channelCount) {
             u32 lutIndex{fraction >> 8};
 
+            // The frames past the end of the buffer are substituted with the last frame
+            std::array<size_t, 4> frames{std::min(inIndex, lastFrame), std::min(inIndex + 1, lastFrame), std::min(inIndex + 2, lastFrame), std::min(inIndex + 3, lastFrame)};
             for (u8 channel{}; channel < channelCount; channel++) {
-                i32 data = inputBuffer[(inIndex + 0) * channelCount + channel] * lut[lutIndex].a +
-                    inputBuffer[(inIndex + 1) * channelCount + channel] * lut[lutIndex].b +
-                    inputBuffer[(inIndex + 2) * channelCount + channel] * lut[lutIndex].c +
-                    inputBuffer[(inIndex + 3) * channelCount + channel] * lut[lutIndex].d;
+                i32 data = inputBuffer[frames[0] * channelCount + channel] * lut[lutIndex].a +
+                    inputBuffer[frames[1] * channelCount + channel] * lut[lutIndex].b +
+                    inputBuffer[frames[2] * channelCount + channel] * lut[lutIndex].c +
+                    inputBuffer[frames[3] * channelCount + channel] * lut[lutIndex].d;
 
                 outputBuffer[outIndex + channel] = Saturate<i16, i32>(data >> 15);
             }
@@ -151,7 +163,5 @@ namespace skyline::audio {
             inIndex += newOffset >> 15;
             fraction = newOffset & 0x7FFF;
         }
-
-        return outputBuffer;
     }
 }
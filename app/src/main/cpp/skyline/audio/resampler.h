@@ -22,5 +22,14 @@ namespace skyline::audio {
          * @param channelCount The amount of channels the buffer contains
          */
         std::vector<i16> ResampleBuffer(std::span<i16> inputBuffer, double ratio, u8 channelCount);
+
+        /**
+         * @brief Resamples the given sample buffer by the given ratio into an existing buffer
+         * @param inputBuffer A buffer containing PCM sample data
+         * @param ratio The conversion ratio needed
+         * @param channelCount The amount of channels the buffer contains
+         * @param outputBuffer The buffer to write the resampled data into, it's resized to fit the output and only reallocated if it's too small
+         */
+        void ResampleBuffer(std::span<const i16> inputBuffer, double ratio, u8 channelCount, std::vector<i16> &outputBuffer);
     };
 }
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <common.h>
+
+namespace skyline::audio {
+    /**
+     * @brief A snapshot of a Histogram, every bucket N holds the amount of values in the range [2^(N-1), 2^N) with bucket 0 holding zeroes
+     */
+    struct HistogramSnapshot {
+        static constexpr size_t BucketCount{40}; //!< The amount of buckets, the last bucket also holds every value that is larger than its range
+
+        std::array<u64, BucketCount> buckets{};
+        u64 count{}; //!< The total amount of recorded values
+        u64 sum{}; //!< The sum of all recorded values
+        u64 max{}; //!< The largest recorded value
+
+        /**
+         * @return The mean of all recorded values
+         */
+        inline u64 Mean() const {
+            return count ? sum / count : 0;
+        }
+
+        /**
+         * @param percentile The percentile to retrieve, from 0 to 100
+         * @return The exclusive upper bound of the bucket containing the percentile, this is accurate to a power of two
+         */
+        inline u64 Percentile(double percentile) const {
+            auto target{static_cast<u64>(static_cast<double>(count) * percentile / 100.0)};
+            u64 accumulated{};
+            for (size_t bucket{}; bucket < BucketCount; bucket++) {
+                accumulated += buckets[bucket];
+                if (accumulated > target)
+                    return std::min(static_cast<u64>(1) << bucket, max);
+            }
+            return max;
+        }
+
+        /**
+         * @brief Adds all values recorded in another snapshot to this one
+         */
+        inline void Merge(const HistogramSnapshot &other) {
+            for (size_t bucket{}; bucket < BucketCount; bucket++)
+                buckets[bucket] += other.buckets[bucket];
+            count += other.count;
+            sum += other.sum;
+            max = std::max(max, other.max);
+        }
+    };
+
+    /**
+     * @brief A lock-free histogram with power of two buckets, it can be recorded into from realtime threads and read from any thread
+     * @note Snapshots aren't atomic as a whole, a value recorded concurrently with a snapshot may only be partially reflected in it
+     */
+    class Histogram {
+      private:
+        std::array<std::atomic<u64>, HistogramSnapshot::BucketCount> buckets{};
+        std::atomic<u64> count{};
+        std::atomic<u64> sum{};
+        std::atomic<u64> max{};
+
+      public:
+        /**
+         * @brief Records a single value into the histogram
+         */
+        inline void Record(u64 value) {
+            auto bucket{std::min(static_cast<size_t>(std::bit_width(value)), HistogramSnapshot::BucketCount - 1)};
+            buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(value, std::memory_order_relaxed);
+
+            auto previous{max.load(std::memory_order_relaxed)};
+            while (previous < value && !max.compare_exchange_weak(previous, value, std::memory_order_relaxed));
+        }
+
+        /**
+         * @return A copy of the current state of the histogram
+         */
+        HistogramSnapshot Snapshot() const {
+            HistogramSnapshot snapshot;
+            for (size_t bucket{}; bucket < HistogramSnapshot::BucketCount; bucket++)
+                snapshot.buckets[bucket] = buckets[bucket].load(std::memory_order_relaxed);
+            snapshot.count = count.load(std::memory_order_relaxed);
+            snapshot.sum = sum.load(std::memory_order_relaxed);
+            snapshot.max = max.load(std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        /**
+         * @brief Clears all recorded values
+         */
+        void Reset() {
+            for (auto &bucket : buckets)
+                bucket.store(0, std::memory_order_relaxed);
+            count.store(0, std::memory_order_relaxed);
+            sum.store(0, std::memory_order_relaxed);
+            max.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief A snapshot of all audio output statistics, this is a plain structure so it can be polled from JNI or from a host test harness
+     */
+    struct AudioStatistics {
+        HistogramSnapshot callbackDuration; //!< The time spent in the output callback in nanoseconds
+        HistogramSnapshot callbackInterval; //!< The time between the starts of consecutive output callbacks in nanoseconds
+        HistogramSnapshot ringFill; //!< The amount of frames queued in a playing track at the start of a callback
+        HistogramSnapshot latency; //!< The time from a buffer being appended to it being fully consumed by the output callback in nanoseconds
+        u64 callbackCount;
+        u64 underrunCount; //!< The amount of callbacks in which a playing track couldn't provide all requested samples
+        i32 xrunCount; //!< The amount of underruns and overruns reported by the output stream
+    };
+}
@@ -5,10 +5,10 @@
 
 namespace skyline::audio {
     AudioTrack::AudioTrack(u8 channelCount, u32 sampleRate, const std::function<void()> &releaseCallback) : channelCount(channelCount), sampleRate(sampleRate), releaseCallback(releaseCallback) {
-        if (sampleRate != constant::SampleRate)
+        if (!sampleRate)
             throw exception("Unsupported audio sample rate: {}", sampleRate);
 
-        if (channelCount != constant::ChannelCount)
+        if (!channelCount)
             throw exception("Unsupported quantity of audio channels: {}", channelCount);
     }
 
@@ -44,24 +44,68 @@ namespace skyline::audio {
         return bufferIds;
     }
 
+    std::span<i16> AudioTrack::ConvertChannels(std::span<i16> buffer) {
+        if (channelCount == constant::ChannelCount)
+            return buffer;
+
+        auto frameCount{buffer.size() / channelCount};
+        channelBuffer.resize(frameCount * constant::ChannelCount);
+
+        if (channelCount == 1) {
+            for (size_t frame{}; frame < frameCount; frame++)
+                channelBuffer[frame * 2] = channelBuffer[frame * 2 + 1] = buffer[frame];
+        } else if (channelCount == 6) {
+            // The channels are in the order: Front Left, Front Right, Center, LFE, Back Left, Back Right
+            constexpr i64 SurroundGain{23170}; //!< 1/sqrt(2) in Q15
+            constexpr i64 NormalizationGain{13573}; //!< 1/(1 + 2/sqrt(2)) in Q15, this prevents the downmix from clipping
+            for (size_t frame{}; frame < frameCount; frame++) {
+                auto source{buffer.data() + frame * 6};
+                // The sum of all channels at full scale exceeds the range of an i32 so this is done in 64-bit
+                i64 center{static_cast<i64>(source[2]) * SurroundGain};
+                i64 left{(static_cast<i64>(source[0]) << 15) + center + static_cast<i64>(source[4]) * SurroundGain};
+                i64 right{(static_cast<i64>(source[1]) << 15) + center + static_cast<i64>(source[5]) * SurroundGain};
+                channelBuffer[frame * 2] = Saturate<i16, i64>((left * NormalizationGain) >> 30);
+                channelBuffer[frame * 2 + 1] = Saturate<i16, i64>((right * NormalizationGain) >> 30);
+            }
+        } else {
+            for (size_t frame{}; frame < frameCount; frame++) {
+                channelBuffer[frame * 2] = buffer[frame * channelCount];
+                channelBuffer[frame * 2 + 1] = buffer[frame * channelCount + 1];
+            }
+        }
+
+        return channelBuffer;
+    }
+
     void AudioTrack::AppendBuffer(u64 tag, std::span<i16> buffer) {
-        BufferIdentifier identifier{
-            .released = false,
-            .tag = tag,
-            .finalSample = identifiers.empty() ? (buffer.size()) : (buffer.size() + identifiers.front().finalSample)
-        };
+        auto appendTime{util::GetTimeNs()};
+        auto output{ConvertChannels(buffer)};
+        if (sampleRate != constant::SampleRate) {
+            resampler.ResampleBuffer(output, static_cast<double>(sampleRate) / constant::SampleRate, constant::ChannelCount, resampleBuffer);
+            output = resampleBuffer;
+        }
 
         std::lock_guard guard(bufferLock);
 
-        identifiers.push_front(identifier);
-        samples.Append(buffer);
+        identifiers.push_front(BufferIdentifier{
+            .tag = tag,
+            .finalSample = identifiers.empty() ? (output.size()) : (output.size() + identifiers.front().finalSample),
+            .appendTime = appendTime,
+            .released = false,
+        });
+        samples.Append(output);
     }
 
     void AudioTrack::CheckReleasedBuffers() {
         bool anyReleased{};
+        u64 now{};
 
         for (auto &identifier : identifiers) {
             if (identifier.finalSample <= sampleCounter && !identifier.released) {
+                if (!anyReleased)
+                    now = util::GetTimeNs();
+                latency.Record(now - identifier.appendTime);
+
                 anyReleased = true;
                 identifier.released = true;
             }
@@ -8,6 +8,8 @@
 #include <kernel/types/KEvent.h>
 #include <common.h>
 #include "common.h"
+#include "resampler.h"
+#include "statistics.h"
 
 namespace skyline::audio {
     /**
@@ -20,6 +22,17 @@ namespace skyline::audio {
 
         u8 channelCount;
         u32 sampleRate;
+        Resampler resampler; //!< The resampler used to convert samples to the output sample rate
+        std::vector<i16> channelBuffer; //!< A reused buffer which holds samples after they've been converted to the output channel layout
+        std::vector<i16> resampleBuffer; //!< A reused buffer which holds samples after they've been converted to the output sample rate
+
+        /**
+         * @brief Converts samples from the track channel layout to the output channel layout
+         * @param buffer The samples in the track channel layout
+         * @return A span containing the samples in the output channel layout, this may alias the input buffer
+         * @note Mono is duplicated to both channels, 5.1 is downmixed according to ITU-R BS.775 without the LFE channel and any other layout uses its first two channels
+         */
+        std::span<i16> ConvertChannels(std::span<i16> buffer);
 
       public:
         CircularBuffer<i16, constant::SampleRate * constant::ChannelCount * 10> samples; //!< A circular buffer with all appended audio samples
@@ -27,6 +40,8 @@ namespace skyline::audio {
 
         AudioOutState playbackState{AudioOutState::Stopped}; //!< The current state of playback
         u64 sampleCounter{}; //!< A counter used for tracking when buffers have been played and can be released
+        u64 underrunCount{}; //!< The amount of callbacks in which this track couldn't provide all requested samples while it still had buffers queued
+        Histogram latency; //!< The time from a buffer being appended to it being fully played in nanoseconds
 
         /**
          * @param channelCount The amount channels that will be present in the track
@@ -62,12 +77,29 @@ namespace skyline::audio {
         std::vector<u64> GetReleasedBuffers(u32 max);
 
         /**
-         * @brief Appends audio samples to the output buffer
+         * @brief Appends audio samples to the output buffer after converting them to the output channel layout and sample rate
          * @param tag The tag of the buffer
-         * @param buffer A span containing the source sample buffer
+         * @param buffer A span containing the source sample buffer in the track channel layout and sample rate
+         * @note Conversion is done prior to locking bufferLock so it never stalls the audio callback
          */
         void AppendBuffer(u64 tag, std::span<i16> buffer = {});
 
+        /**
+         * @return If any appended buffers haven't been fully played yet
+         * @note bufferLock MUST be locked when calling this
+         */
+        inline bool HasPendingBuffers() {
+            return !identifiers.empty() && identifiers.front().finalSample > sampleCounter;
+        }
+
+        /**
+         * @return The amount of frames that have been appended but not played yet
+         * @note bufferLock MUST be locked when calling this
+         */
+        inline u64 GetQueuedFrames() {
+            return HasPendingBuffers() ? (identifiers.front().finalSample - sampleCounter) / constant::ChannelCount : 0;
+        }
+
         /**
          * @brief Checks if any buffers have been released and calls the appropriate callback for them
          * @note bufferLock MUST be locked when calling this
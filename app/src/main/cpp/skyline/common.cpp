@@ -16,7 +16,7 @@ namespace skyline {
                 if (!flag.test_and_set(std::memory_order_acquire))
                     return;
 
-                asm volatile("yield");
+                util::SpinPause();
             }
             sched_yield();
         }
@@ -54,7 +54,7 @@ namespace skyline {
             }
 
             none = Group::None;
-            asm volatile("yield");
+            util::SpinPause();
         }
     }
 
@@ -105,14 +105,29 @@ namespace skyline {
         return stringMap.at(key);
     }
 
+    std::string Settings::GetString(const std::string &key, const std::string &fallback) {
+        auto it{stringMap.find(key)};
+        return (it != stringMap.end()) ? it->second : fallback;
+    }
+
     bool Settings::GetBool(const std::string &key) {
         return boolMap.at(key);
     }
 
+    bool Settings::GetBool(const std::string &key, bool fallback) {
+        auto it{boolMap.find(key)};
+        return (it != boolMap.end()) ? it->second : fallback;
+    }
+
     int Settings::GetInt(const std::string &key) {
         return intMap.at(key);
     }
 
+    int Settings::GetInt(const std::string &key, int fallback) {
+        auto it{intMap.find(key)};
+        return (it != intMap.end()) ? it->second : fallback;
+    }
+
     void Settings::List(const std::shared_ptr<Logger> &logger) {
         for (auto &iter : stringMap)
             logger->Info("Key: {}, Value: {}, Type: String", iter.first, GetString(iter.first));
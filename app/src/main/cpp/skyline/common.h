@@ -12,6 +12,7 @@
 #include <thread>
 #include <string>
 #include <cstdint>
+#include <ctime>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -86,22 +87,44 @@ namespace skyline {
          * @return The current time in nanoseconds
          */
         inline u64 GetTimeNs() {
+            #if defined(__aarch64__)
             static u64 frequency{};
             if (!frequency)
                 asm("MRS %0, CNTFRQ_EL0" : "=r"(frequency));
             u64 ticks;
             asm("MRS %0, CNTVCT_EL0" : "=r"(ticks));
             return ((ticks / frequency) * constant::NsInSecond) + (((ticks % frequency) * constant::NsInSecond + (frequency / 2)) / frequency);
+            #else
+            timespec time;
+            clock_gettime(CLOCK_MONOTONIC, &time);
+            return static_cast<u64>(time.tv_sec) * constant::NsInSecond + static_cast<u64>(time.tv_nsec);
+            #endif
         }
 
         /**
          * @brief Returns the current time in arbitrary ticks
          * @return The current time in ticks
+         * @note Hosts without a generic timer use nanoseconds as ticks
          */
         inline u64 GetTimeTicks() {
+            #if defined(__aarch64__)
             u64 ticks;
             asm("MRS %0, CNTVCT_EL0" : "=r"(ticks));
             return ticks;
+            #else
+            return GetTimeNs();
+            #endif
+        }
+
+        /**
+         * @brief Hints to the CPU that the calling thread is busy-waiting
+         */
+        inline void SpinPause() {
+            #if defined(__aarch64__)
+            asm volatile("yield");
+            #elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+            #endif
         }
 
         /**
@@ -389,6 +412,12 @@ namespace skyline {
          */
         std::string GetString(const std::string &key);
 
+        /**
+         * @brief Retrieves a particular setting as a string or a fallback if it doesn't exist
+         * @note This should be used for any setting that might not exist in the preferences of an older install
+         */
+        std::string GetString(const std::string &key, const std::string &fallback);
+
         /**
          * @brief Retrieves a particular setting as a boolean
          * @param key The key of the setting
@@ -396,6 +425,12 @@ namespace skyline {
          */
         bool GetBool(const std::string &key);
 
+        /**
+         * @brief Retrieves a particular setting as a boolean or a fallback if it doesn't exist
+         * @note This should be used for any setting that might not exist in the preferences of an older install
+         */
+        bool GetBool(const std::string &key, bool fallback);
+
         /**
          * @brief Retrieves a particular setting as a integer
          * @param key The key of the setting
@@ -403,6 +438,12 @@ namespace skyline {
          */
         int GetInt(const std::string &key);
 
+        /**
+         * @brief Retrieves a particular setting as a integer or a fallback if it doesn't exist
+         * @note This should be used for any setting that might not exist in the preferences of an older install
+         */
+        int GetInt(const std::string &key, int fallback);
+
         /**
          * @brief Writes all settings keys and values to syslog. This function is for development purposes.
          */
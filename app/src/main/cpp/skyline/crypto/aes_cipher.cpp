@@ -11,6 +11,9 @@ namespace skyline::crypto {
 
         if (mbedtls_cipher_setkey(&decryptContext, key.data(), key.size() * 8, MBEDTLS_DECRYPT) != 0)
             throw exception("Failed to set key for decryption context");
+
+        if (type == MBEDTLS_CIPHER_AES_128_CTR && hw::IsAesSupported())
+            hwRoundKeys = hw::ExpandKey128(std::span<const u8, 0x10>(key.data(), 0x10));
     }
 
     AesCipher::~AesCipher() {
@@ -59,6 +62,21 @@ namespace skyline::crypto {
             std::memcpy(destination, buffer.data(), size);
     }
 
+    void AesCipher::CtrDecrypt(u8 *destination, u8 *source, size_t size, const std::array<u8, 0x10> &ctr) {
+        if (hwRoundKeys) {
+            hw::CtrTransform(*hwRoundKeys, ctr, destination, source, size);
+            return;
+        }
+
+        // CTR is a stream cipher so mbedtls can process the entire span in a single call, this also works in-place
+        SetIV(ctr);
+        mbedtls_cipher_reset(&decryptContext);
+
+        size_t outputSize{};
+        if (mbedtls_cipher_update(&decryptContext, source, size, destination, &outputSize) != 0)
+            throw exception("Failed to decrypt data with AES-CTR");
+    }
+
     void AesCipher::XtsDecrypt(u8 *destination, u8 *source, size_t size, size_t sector, size_t sectorSize) {
         if (size % sectorSize)
             throw exception("Size must be multiple of sector size");
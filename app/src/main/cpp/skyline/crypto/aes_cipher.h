@@ -7,6 +7,7 @@
 #include <span>
 #include <mbedtls/cipher.h>
 #include <common.h>
+#include "aes_hw.h"
 
 namespace skyline::crypto {
     /**
@@ -16,6 +17,8 @@ namespace skyline::crypto {
       private:
         mbedtls_cipher_context_t decryptContext;
 
+        std::optional<hw::RoundKeys> hwRoundKeys; //!< The round keys for the hardware AES-CTR backend, this is only set for AES-128-CTR ciphers on hosts with AES instructions
+
         /**
          * @brief Buffer should grow bigger than 1 MiB
          */
@@ -58,6 +61,20 @@ namespace skyline::crypto {
             Decrypt(data.data(), data.data(), data.size());
         }
 
+        /**
+         * @brief Decrypts data with CTR in a single pass, using the hardware backend if it's available
+         * @param ctr The counter of the first block, this should be block aligned
+         * @note destination and source can be the same, the cipher must've been created with MBEDTLS_CIPHER_AES_128_CTR
+         */
+        void CtrDecrypt(u8 *destination, u8 *source, size_t size, const std::array<u8, 0x10> &ctr);
+
+        /**
+         * @brief Decrypts data with CTR and writes back to it
+         */
+        inline void CtrDecrypt(std::span<u8> data, const std::array<u8, 0x10> &ctr) {
+            CtrDecrypt(data.data(), data.data(), data.size(), ctr);
+        }
+
         /**
          * @brief Decrypts data with XTS. IV will get calculated with the given sector
          */
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include "aes_hw.h"
+
+namespace skyline::crypto::hw {
+    constexpr size_t BlockSize{0x10};
+    constexpr size_t Interleave{4}; //!< The amount of blocks that are processed at once to hide the latency of the AES instructions
+
+    // @fmt:off
+    constexpr std::array<u8, 256> SBox{
+        0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+        0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+        0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+        0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+        0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+        0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+        0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+        0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+        0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+        0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+        0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+        0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+        0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+        0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+        0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+        0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+    };
+    // @fmt:on
+
+    bool IsAesSupported() {
+        static const bool supported{[] {
+            #if defined(__aarch64__)
+            return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+            #elif defined(__x86_64__)
+            return __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse4.1");
+            #else
+            return false;
+            #endif
+        }()};
+        return supported;
+    }
+
+    RoundKeys ExpandKey128(std::span<const u8, 0x10> key) {
+        constexpr std::array<u8, 10> RoundConstants{0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+        RoundKeys roundKeys;
+        std::memcpy(roundKeys[0].data(), key.data(), BlockSize);
+
+        for (size_t round{1}; round < roundKeys.size(); round++) {
+            auto &previous{roundKeys[round - 1]};
+            auto &current{roundKeys[round]};
+
+            // RotWord and SubWord on the last word of the previous round key
+            std::array<u8, 4> word{SBox[previous[13]], SBox[previous[14]], SBox[previous[15]], SBox[previous[12]]};
+            word[0] ^= RoundConstants[round - 1];
+
+            for (size_t index{}; index < BlockSize; index++)
+                current[index] = previous[index] ^ (index < 4 ? word[index] : current[index - 4]);
+        }
+
+        return roundKeys;
+    }
+
+    /**
+     * @brief A 128-bit big-endian counter which is stored in host byte order for cheap increments
+     */
+    struct Counter {
+        u64 high;
+        u64 low;
+
+        Counter(const std::array<u8, 0x10> &counter) {
+            std::memcpy(&high, counter.data(), sizeof(u64));
+            std::memcpy(&low, counter.data() + sizeof(u64), sizeof(u64));
+            high = __builtin_bswap64(high);
+            low = __builtin_bswap64(low);
+        }
+
+        /**
+         * @brief Writes the counter to the specified block in big-endian order and increments it
+         */
+        inline void Store(u8 *block) {
+            auto highBe{__builtin_bswap64(high)}, lowBe{__builtin_bswap64(low)};
+            std::memcpy(block, &highBe, sizeof(u64));
+            std::memcpy(block + sizeof(u64), &lowBe, sizeof(u64));
+            if (!++low)
+                high++;
+        }
+    };
+
+    #if defined(__aarch64__)
+    /**
+     * @brief Applies a single full AES round (AESE + AESMC) to multiple blocks
+     * @note Inline assembly is used rather than intrinsics so this doesn't require the whole translation unit to be built with the crypto extension
+     */
+    inline void Round(uint8x16_t (&blocks)[Interleave], uint8x16_t key) {
+        asm(".arch_extension crypto\n"
+            "aese %0.16b, %4.16b\n"
+            "aesmc %0.16b, %0.16b\n"
+            "aese %1.16b, %4.16b\n"
+            "aesmc %1.16b, %1.16b\n"
+            "aese %2.16b, %4.16b\n"
+            "aesmc %2.16b, %2.16b\n"
+            "aese %3.16b, %4.16b\n"
+            "aesmc %3.16b, %3.16b\n"
+            : "+w"(blocks[0]), "+w"(blocks[1]), "+w"(blocks[2]), "+w"(blocks[3])
+            : "w"(key));
+    }
+
+    /**
+     * @brief Applies the final AES round without MixColumns to multiple blocks, the last round key is applied separately
+     */
+    inline void FinalRound(uint8x16_t (&blocks)[Interleave], uint8x16_t key) {
+        asm(".arch_extension crypto\n"
+            "aese %0.16b, %4.16b\n"
+            "aese %1.16b, %4.16b\n"
+            "aese %2.16b, %4.16b\n"
+            "aese %3.16b, %4.16b\n"
+            : "+w"(blocks[0]), "+w"(blocks[1]), "+w"(blocks[2]), "+w"(blocks[3])
+            : "w"(key));
+    }
+
+    void CtrTransform(const RoundKeys &roundKeys, const std::array<u8, 0x10> &counter, u8 *destination, const u8 *source, size_t size) {
+        uint8x16_t keys[11]; // std::array isn't used for vector types as it'd discard their alignment attributes
+        for (size_t round{}; round < 11; round++)
+            keys[round] = vld1q_u8(roundKeys[round].data());
+
+        Counter ctr(counter);
+        std::array<u8, BlockSize * Interleave> counterBlocks;
+        std::array<u8, BlockSize * Interleave> keystream;
+
+        for (size_t offset{}; offset < size; offset += BlockSize * Interleave) {
+            uint8x16_t blocks[Interleave];
+            for (size_t block{}; block < Interleave; block++) {
+                ctr.Store(counterBlocks.data() + block * BlockSize);
+                blocks[block] = vld1q_u8(counterBlocks.data() + block * BlockSize);
+            }
+
+            for (size_t round{}; round < 9; round++)
+                Round(blocks, keys[round]);
+            FinalRound(blocks, keys[9]);
+
+            auto remaining{std::min(size - offset, BlockSize * Interleave)};
+            if (remaining == BlockSize * Interleave) {
+                for (size_t block{}; block < Interleave; block++) {
+                    auto data{vld1q_u8(source + offset + block * BlockSize)};
+                    vst1q_u8(destination + offset + block * BlockSize, veorq_u8(data, veorq_u8(blocks[block], keys[10])));
+                }
+            } else {
+                for (size_t block{}; block < Interleave; block++)
+                    vst1q_u8(keystream.data() + block * BlockSize, veorq_u8(blocks[block], keys[10]));
+                for (size_t index{}; index < remaining; index++)
+                    destination[offset + index] = source[offset + index] ^ keystream[index];
+            }
+        }
+    }
+    #elif defined(__x86_64__)
+    __attribute__((target("aes,sse4.1"))) void CtrTransform(const RoundKeys &roundKeys, const std::array<u8, 0x10> &counter, u8 *destination, const u8 *source, size_t size) {
+        __m128i keys[11]; // std::array isn't used for vector types as it'd discard their alignment attributes
+        for (size_t round{}; round < 11; round++)
+            keys[round] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(roundKeys[round].data()));
+
+        Counter ctr(counter);
+        std::array<u8, BlockSize * Interleave> counterBlocks;
+        std::array<u8, BlockSize * Interleave> keystream;
+
+        for (size_t offset{}; offset < size; offset += BlockSize * Interleave) {
+            __m128i blocks[Interleave];
+            for (size_t block{}; block < Interleave; block++) {
+                ctr.Store(counterBlocks.data() + block * BlockSize);
+                blocks[block] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(counterBlocks.data() + block * BlockSize)), keys[0]);
+            }
+
+            for (size_t round{1}; round < 10; round++)
+                for (auto &block : blocks)
+                    block = _mm_aesenc_si128(block, keys[round]);
+            for (auto &block : blocks)
+                block = _mm_aesenclast_si128(block, keys[10]);
+
+            auto remaining{std::min(size - offset, BlockSize * Interleave)};
+            if (remaining == BlockSize * Interleave) {
+                for (size_t block{}; block < Interleave; block++) {
+                    auto data{_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + offset + block * BlockSize))};
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + offset + block * BlockSize), _mm_xor_si128(data, blocks[block]));
+                }
+            } else {
+                for (size_t block{}; block < Interleave; block++)
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(keystream.data() + block * BlockSize), blocks[block]);
+                for (size_t index{}; index < remaining; index++)
+                    destination[offset + index] = source[offset + index] ^ keystream[index];
+            }
+        }
+    }
+    #else
+    void CtrTransform(const RoundKeys &roundKeys, const std::array<u8, 0x10> &counter, u8 *destination, const u8 *source, size_t size) {
+        throw exception("AES instructions aren't supported on this architecture");
+    }
+    #endif
+}
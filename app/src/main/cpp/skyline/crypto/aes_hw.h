@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <common.h>
+
+namespace skyline::crypto::hw {
+    using RoundKeys = std::array<std::array<u8, 0x10>, 11>; //!< The expanded encryption key schedule of AES-128
+
+    /**
+     * @return If the host CPU supports AES instructions (ARMv8 Crypto Extensions or AES-NI), this is determined at runtime and cached
+     */
+    bool IsAesSupported();
+
+    /**
+     * @brief Expands an AES-128 key into the round keys used for encryption
+     */
+    RoundKeys ExpandKey128(std::span<const u8, 0x10> key);
+
+    /**
+     * @brief Encrypts or decrypts data with AES-128-CTR using the host AES instructions
+     * @param roundKeys The round keys produced by ExpandKey128
+     * @param counter The counter of the first block, it's incremented as a 128-bit big-endian integer for every subsequent block
+     * @param size The size of the data, the keystream of a trailing partial block is truncated
+     * @note This must only be called if IsAesSupported returns true, destination and source can be the same
+     */
+    void CtrTransform(const RoundKeys &roundKeys, const std::array<u8, 0x10> &counter, u8 *destination, const u8 *source, size_t size);
+}
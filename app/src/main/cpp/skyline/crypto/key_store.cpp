@@ -3,10 +3,12 @@
 
 #include <functional>
 #include <vfs/os_filesystem.h>
+#include <profile.h>
 #include "key_store.h"
 
 namespace skyline::crypto {
     KeyStore::KeyStore(const std::string &rootPath) {
+        profile::ScopedTimer timer{profile::Stage::KeyStore};
         vfs::OsFileSystem root(rootPath);
         if (root.FileExists("title.keys"))
             ReadPairs(root.OpenFile("title.keys"), &KeyStore::PopulateTitleKeys);
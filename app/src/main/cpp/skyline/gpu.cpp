@@ -42,9 +42,18 @@ namespace skyline::gpu {
             return;
         }
 
-        if (!presentationQueue.empty()) {
-            auto &texture = presentationQueue.front();
-            presentationQueue.pop();
+        std::shared_ptr<PresentationTexture> texture;
+        {
+            std::lock_guard lock(presentationMutex);
+            if (!presentationQueue.empty() && IsPresentable(presentationQueue.front())) {
+                texture = std::move(presentationQueue.front().texture);
+                presentationQueue.pop();
+            }
+        }
+
+        if (texture) {
+            // The buffer is synchronized here rather than when it's queued so the guest doesn't wait on the deswizzle
+            texture->SynchronizeHost();
 
             auto textureFormat = texture->GetAndroidFormat();
             if (resolution != texture->dimensions || textureFormat != format) {
@@ -75,4 +84,25 @@ namespace skyline::gpu {
             }
         }
     }
+
+    bool GPU::IsPresentable(const PresentationRequest &request) {
+        constexpr u64 FenceTimeout{constant::NsInSecond / 10}; // A fence that isn't reached in this time is assumed to be stale to avoid stalling presentation
+
+        if (util::GetTimeNs() - request.timestamp > FenceTimeout)
+            return true;
+
+        for (const auto &fence : request.fences)
+            if (fence.id < syncpoints.size() && syncpoints[fence.id].value < fence.value)
+                return false;
+
+        return true;
+    }
+
+    void GPU::QueuePresentation(const std::shared_ptr<PresentationTexture> &texture, std::span<const service::nvdrv::Fence> fences) {
+        PresentationRequest request{texture, {}, util::GetTimeNs()};
+        std::copy_n(fences.begin(), std::min(fences.size(), request.fences.size()), request.fences.begin());
+
+        std::lock_guard lock(presentationMutex);
+        presentationQueue.push(std::move(request));
+    }
 }
@@ -8,9 +8,11 @@
 #include <kernel/ipc.h>
 #include <kernel/types/KEvent.h>
 #include <services/nvdrv/devices/nvmap.h>
+#include <services/common/fence.h>
 #include "gpu/texture.h"
 #include "gpu/memory_manager.h"
 #include "gpu/gpfifo.h"
+#include "gpu/capture.h"
 #include "gpu/syncpoint.h"
 #include "gpu/engines/engine.h"
 #include "gpu/engines/maxwell_3d.h"
@@ -27,8 +29,24 @@ namespace skyline::gpu {
         bool surfaceUpdate{}; //!< If the surface needs to be updated
         u64 frameTimestamp{}; //!< The timestamp of the last frame being shown
 
+        /**
+         * @brief A buffer that has been queued for presentation alongside the fences which have to be reached before its contents are complete
+         */
+        struct PresentationRequest {
+            std::shared_ptr<PresentationTexture> texture;
+            std::array<service::nvdrv::Fence, 4> fences;
+            u64 timestamp; //!< The time the request was queued at, fences are only waited on for a limited time after this
+        };
+
+        std::queue<PresentationRequest> presentationQueue; //!< A queue of all the PresentationTextures to be synchronized and posted to the display
+        std::mutex presentationMutex; //!< Synchronizes access to the presentation queue as buffers are queued by guest threads
+
+        /**
+         * @return If all fences of a request have been reached or have been waited on for too long
+         */
+        bool IsPresentable(const PresentationRequest &request);
+
       public:
-        std::queue<std::shared_ptr<PresentationTexture>> presentationQueue; //!< A queue of all the PresentationTextures to be posted to the display
         texture::Dimensions resolution{}; //!< The resolution of the surface
         i32 format{}; //!< The format of the display window
         std::shared_ptr<kernel::type::KEvent> vsyncEvent; //!< This KEvent is triggered every time a frame is drawn
@@ -41,6 +59,7 @@ namespace skyline::gpu {
         std::shared_ptr<engine::Engine> keplerMemory;
         gpfifo::GPFIFO gpfifo;
         std::array<Syncpoint, constant::MaxHwSyncpointCount> syncpoints{};
+        std::unique_ptr<capture::Recorder> recorder; //!< The recorder of all GPFIFO submissions, this is only created when GPU capture is enabled
 
         /**
          * @param window The ANativeWindow to render to
@@ -56,5 +75,11 @@ namespace skyline::gpu {
          * @brief The loop that executes routine GPU functions
          */
         void Loop();
+
+        /**
+         * @brief Queues a buffer to be synchronized from the guest and presented by the GPU thread once all of its fences have been reached
+         * @note The release callback of the texture is called after it has been presented, the guest must not write to it till then
+         */
+        void QueuePresentation(const std::shared_ptr<PresentationTexture> &texture, std::span<const service::nvdrv::Fence> fences);
     };
 }
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "memory_manager.h"
+#include "capture.h"
+
+namespace skyline::gpu::capture {
+    Recorder::Recorder(const std::string &path, const vmm::MemoryManager &memoryManager) : stream(path, std::ios::binary | std::ios::trunc) {
+        if (!stream)
+            throw exception("Failed to open the GPU capture file: {}", path);
+
+        Write(FileHeader{Magic, Version});
+
+        for (const auto &chunk : memoryManager.chunkList)
+            if (chunk.state == vmm::ChunkState::Mapped)
+                RecordMap(chunk.address, chunk.size);
+    }
+
+    void Recorder::WriteRecord(RecordType type, u32 size) {
+        Write(RecordHeader{type, size});
+    }
+
+    void Recorder::RecordMap(u64 address, u64 size) {
+        std::lock_guard guard(mutex);
+        WriteRecord(RecordType::Map, sizeof(MapRecord));
+        Write(MapRecord{address, size});
+    }
+
+    void Recorder::RecordUnmap(u64 address) {
+        std::lock_guard guard(mutex);
+        WriteRecord(RecordType::Unmap, sizeof(u64));
+        Write(address);
+    }
+
+    void Recorder::RecordSubmission(std::span<gpfifo::GpEntry> entries, const vmm::MemoryManager &memoryManager) {
+        std::lock_guard guard(mutex);
+
+        constexpr size_t EntryWords{sizeof(gpfifo::GpEntry) / sizeof(u32)};
+        submission.clear();
+        submission.push_back(static_cast<u32>(entries.size()));
+        for (const auto &entry : entries) {
+            auto offset{submission.size()};
+            submission.resize(offset + EntryWords + entry.size);
+            std::memcpy(submission.data() + offset, &entry, sizeof(gpfifo::GpEntry));
+
+            if (entry.size)
+                memoryManager.Read(std::span(submission.data() + offset + EntryWords, entry.size), (static_cast<u64>(entry.getHi) << 32) | (static_cast<u64>(entry.get) << 2));
+        }
+
+        WriteRecord(RecordType::Submission, static_cast<u32>(submission.size() * sizeof(u32)));
+        stream.write(reinterpret_cast<const char *>(submission.data()), static_cast<std::streamsize>(submission.size() * sizeof(u32)));
+    }
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <fstream>
+#include <mutex>
+#include <common.h>
+#include "gpfifo.h"
+
+namespace skyline::gpu::capture {
+    constexpr u32 Magic{util::MakeMagic<u32>("SKGC")}; //!< The magic at the start of a capture file
+    constexpr u32 Version{1}; //!< The version of the capture format, this is incremented whenever the layout of any record changes
+
+    /**
+     * @brief The header at the start of a capture file, it's followed by a sequence of records until the end of the file
+     */
+    struct FileHeader {
+        u32 magic; //!< The magic "SKGC"
+        u32 version; //!< The version of the capture format
+    };
+    static_assert(sizeof(FileHeader) == 0x8);
+
+    /**
+     * @brief The types of records in a capture
+     */
+    enum class RecordType : u32 {
+        Map = 0, //!< A region of the GPU address space was mapped, the payload is a MapRecord
+        Unmap = 1, //!< A mapping was removed from the GPU address space, the payload is the u64 address of the mapping
+        Submission = 2, //!< GP entries were submitted, the payload is a SubmissionRecord
+    };
+
+    /**
+     * @brief The header of every record, it's followed by a payload of the type's layout
+     */
+    struct RecordHeader {
+        RecordType type; //!< The type of the record
+        u32 size; //!< The size of the payload in bytes
+    };
+    static_assert(sizeof(RecordHeader) == 0x8);
+
+    /**
+     * @brief A region of the GPU address space which is mapped to guest memory, only the layout of the address space is captured as the GPU front-end never reads memory that isn't a pushbuffer
+     */
+    struct MapRecord {
+        u64 address; //!< The address of the region in the GPU address space
+        u64 size; //!< The size of the region in bytes
+    };
+    static_assert(sizeof(MapRecord) == 0x10);
+
+    /**
+     * @brief The payload of a submission, it's made up of 'entryCount' GP entries which are each followed by the 'size' words of their pushbuffer
+     * @note The contents of pushbuffers are captured at the time of submission as the guest is free to overwrite them afterwards
+     */
+    struct SubmissionRecord {
+        u32 entryCount; //!< The amount of GP entries in the submission
+    };
+    static_assert(sizeof(SubmissionRecord) == 0x4);
+
+    /**
+     * @brief The Recorder class writes a capture of all GPFIFO submissions and the GPU address space mappings they depend on to a file
+     * @note All functions are thread-safe as submissions can come from any guest thread
+     */
+    class Recorder {
+      private:
+        std::ofstream stream;
+        std::mutex mutex; //!< Serializes writes to the stream so records aren't interleaved
+        std::vector<u32> submission; //!< A reused buffer which holds the payload of the submission being recorded, it's only written out once all pushbuffers were read successfully
+
+        void WriteRecord(RecordType type, u32 size);
+
+        template<typename Type>
+        void Write(const Type &object) {
+            stream.write(reinterpret_cast<const char *>(&object), sizeof(Type));
+        }
+
+      public:
+        /**
+         * @param path The path of the capture file, it's truncated if it already exists
+         * @param memoryManager The GPU address space, all regions which are already mapped are recorded
+         */
+        Recorder(const std::string &path, const vmm::MemoryManager &memoryManager);
+
+        void RecordMap(u64 address, u64 size);
+
+        void RecordUnmap(u64 address);
+
+        /**
+         * @brief Records a submission of GP entries with the current contents of their pushbuffers
+         */
+        void RecordSubmission(std::span<gpfifo::GpEntry> entries, const vmm::MemoryManager &memoryManager);
+    };
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <common.h>
 
 #define U32_OFFSET(regs, field) (offsetof(regs, field) / sizeof(u32))
@@ -48,6 +49,18 @@ namespace skyline::gpu {
             virtual void CallMethod(MethodParams params) {
                 state.logger->Warn("Called method in unimplemented engine: 0x{:X} args: 0x{:X}", params.method, params.argument);
             };
+
+            /**
+            * @brief Calls a run of engine methods with consecutive arguments from a pushbuffer
+            * @param method The method the first argument is sent to
+            * @param arguments The arguments to send, these go to consecutive methods if increment is set or all to the same method otherwise
+            * @param lastCall If the final argument is the last call in the pushbuffer entry
+            * @note This is equivalent to calling CallMethod for every argument, engines override it to handle the run as a block where that's possible
+            */
+            virtual void CallMethods(u16 method, std::span<const u32> arguments, u32 subChannel, bool increment, bool lastCall) {
+                for (size_t index{}; index < arguments.size(); index++)
+                    CallMethod(MethodParams{static_cast<u16>(increment ? method + index : method), arguments[index], subChannel, lastCall && index == arguments.size() - 1});
+            }
         };
     }
 }
@@ -6,6 +6,87 @@
 #include "maxwell_3d.h"
 
 namespace skyline::gpu::engine {
+    namespace {
+        using StateBlock = Maxwell3D::StateBlock;
+
+        /**
+         * @brief A range of registers that belong to a state block
+         */
+        struct StateBlockRange {
+            StateBlock block;
+            u16 offset;
+            u16 size;
+            bool alwaysDirty{}; //!< If writes to these registers mark them dirty even when the value is unchanged, this is the case for registers that stream data
+        };
+
+        /**
+         * @note Registers which aren't in the register structure yet are described by their offset
+         * @url https://github.com/devkitPro/deko3d/blob/master/source/maxwell/engine_3d.def
+         */
+        constexpr std::array<StateBlockRange, 22> StateBlockRanges{{
+            {StateBlock::Viewport, MAXWELL3D_OFFSET(viewportTransform), 0x80},
+            {StateBlock::Viewport, MAXWELL3D_OFFSET(viewport), 0x40},
+            {StateBlock::Viewport, MAXWELL3D_OFFSET(viewportTransformEnable), 1},
+            {StateBlock::Scissor, 0x380, 0x40}, // 16 scissors of enable, horizontal, vertical and padding
+            {StateBlock::Blend, MAXWELL3D_OFFSET(blendConstant), 4},
+            {StateBlock::Blend, MAXWELL3D_OFFSET(blend), sizeof(Maxwell3D::Registers::blend) / sizeof(u32)},
+            {StateBlock::Blend, MAXWELL3D_OFFSET(colorMask), 8},
+            {StateBlock::Blend, MAXWELL3D_OFFSET(independentBlend), 0x40},
+            {StateBlock::Depth, 0x4B3, 1}, // Depth test enable
+            {StateBlock::Depth, 0x4BA, 1}, // Depth write enable
+            {StateBlock::Depth, MAXWELL3D_OFFSET(depthTestFunc), 1},
+            {StateBlock::Depth, MAXWELL3D_OFFSET(stencilEnable), 8},
+            {StateBlock::Depth, MAXWELL3D_OFFSET(stencilBackExtra), 3},
+            {StateBlock::Depth, MAXWELL3D_OFFSET(stencilTwoSideEnable), 5},
+            {StateBlock::VertexAttributes, MAXWELL3D_OFFSET(vertexAttributeState), 0x20},
+            {StateBlock::VertexAttributes, 0x700, 0x40}, // 16 vertex streams of format, address and divisor
+            {StateBlock::VertexAttributes, 0x7C0, 0x20}, // 16 vertex stream limit addresses
+            {StateBlock::RenderTargets, 0x200, 0x80}, // 8 color render targets
+            {StateBlock::RenderTargets, 0x3F8, 5}, // The depth render target
+            {StateBlock::RenderTargets, 0x487, 1}, // The render target control
+            {StateBlock::ConstantBuffers, 0x8E0, 0x14, true}, // The constant buffer selector and inline update data
+            {StateBlock::ConstantBuffers, 0x900, 0x28}, // The constant buffer bindings of all 5 shader stages
+        }};
+
+        constexpr u8 AlwaysDirtyFlag{1 << 7};
+
+        /**
+         * @brief A mask of the state blocks which every register belongs to, alongside AlwaysDirtyFlag
+         */
+        constexpr auto RegisterStateBlocks{[] {
+            std::array<u8, constant::Maxwell3DRegisterCounter> table{};
+            for (const auto &range : StateBlockRanges)
+                for (u16 offset{range.offset}; offset < range.offset + range.size; offset++)
+                    table[offset] |= static_cast<u8>((1 << static_cast<u8>(range.block)) | (range.alwaysDirty ? AlwaysDirtyFlag : 0));
+            return table;
+        }()};
+
+        /**
+         * @brief The amount of consecutive registers starting at every register which are either all in a state block or all outside of one
+         */
+        constexpr auto RegisterRunLengths{[] {
+            std::array<u16, constant::Maxwell3DRegisterCounter> table{};
+            table.back() = 1;
+            for (size_t offset{constant::Maxwell3DRegisterCounter - 1}; offset-- > 0;)
+                table[offset] = static_cast<u16>((static_cast<bool>(RegisterStateBlocks[offset]) == static_cast<bool>(RegisterStateBlocks[offset + 1])) ? table[offset + 1] + 1 : 1);
+            return table;
+        }()};
+
+        /**
+         * @brief The registers which trigger an action when written to, these must be kept in sync with the cases in Maxwell3D::CallMethod and sorted
+         * @note Writes to these registers are never filtered as repeating a write repeats its action
+         */
+        constexpr std::array<u16, 6> SideEffectRegisters{
+            MAXWELL3D_OFFSET(mme.instructionRamLoad),
+            MAXWELL3D_OFFSET(mme.startAddressRamLoad),
+            MAXWELL3D_OFFSET(mme.shadowRamControl),
+            MAXWELL3D_OFFSET(syncpointAction),
+            MAXWELL3D_OFFSET(semaphore.info),
+            MAXWELL3D_OFFSET(firmwareCall[4]),
+        };
+        static_assert(std::is_sorted(SideEffectRegisters.begin(), SideEffectRegisters.end()));
+    }
+
     Maxwell3D::Maxwell3D(const DeviceState &state) : Engine(state), macroInterpreter(*this) {
         ResetRegs();
     }
@@ -13,6 +94,10 @@ namespace skyline::gpu::engine {
     void Maxwell3D::ResetRegs() {
         registers = {};
 
+        // Every register is considered to have changed after a reset as nothing is known about the previous state
+        dirtyRegisters.set();
+        dirtyBlocks.set();
+
         registers.rasterizerEnable = true;
 
         for (auto &transform : registers.viewportTransform) {
@@ -77,8 +162,8 @@ namespace skyline::gpu::engine {
     void Maxwell3D::CallMethod(MethodParams params) {
         state.logger->Debug("Called method in Maxwell 3D: 0x{:X} args: 0x{:X}", params.method, params.argument);
 
-        // Methods that are greater than the register size are for macro control
-        if (params.method > constant::Maxwell3DRegisterCounter) {
+        // Methods past the end of the register space are for macro control
+        if (params.method >= constant::Maxwell3DRegisterCounter) {
             if (!(params.method & 1))
                 macroInvocation.index = ((params.method - constant::Maxwell3DRegisterCounter) >> 1) % macroPositions.size();
 
@@ -94,12 +179,9 @@ namespace skyline::gpu::engine {
             return;
         }
 
-        registers.raw[params.method] = params.argument;
-
-        if (shadowRegisters.mme.shadowRamControl == Registers::MmeShadowRamControl::MethodTrack || shadowRegisters.mme.shadowRamControl == Registers::MmeShadowRamControl::MethodTrackWithFilter)
-            shadowRegisters.raw[params.method] = params.argument;
-        else if (shadowRegisters.mme.shadowRamControl == Registers::MmeShadowRamControl::MethodReplay)
-            params.argument = shadowRegisters.raw[params.method];
+        // Writes without any effect are dropped before any of the side effects are handled
+        if (!WriteRegister(params.method, params.argument, std::binary_search(SideEffectRegisters.begin(), SideEffectRegisters.end(), params.method)))
+            return;
 
         switch (params.method) {
             case MAXWELL3D_OFFSET(mme.instructionRamLoad):
@@ -118,6 +200,8 @@ namespace skyline::gpu::engine {
                 shadowRegisters.mme.shadowRamControl = static_cast<Registers::MmeShadowRamControl>(params.argument);
                 break;
             case MAXWELL3D_OFFSET(syncpointAction):
+                // The guest expects all prior semaphore writes to be visible once the syncpoint is reached
+                FlushSemaphores();
                 state.gpu->syncpoints.at(registers.syncpointAction.id).Increment();
                 break;
             case MAXWELL3D_OFFSET(semaphore.info):
@@ -139,6 +223,133 @@ namespace skyline::gpu::engine {
         }
     }
 
+    void Maxwell3D::CallMethods(u16 method, std::span<const u32> arguments, u32 subChannel, bool increment, bool lastCall) {
+        state.logger->Debug("Called methods in Maxwell 3D: 0x{:X} count: {} increment: {}", method, arguments.size(), increment);
+
+        auto callIndividually{[&](u16 first, std::span<const u32> run) {
+            for (size_t index{}; index < run.size(); index++)
+                CallMethod(MethodParams{static_cast<u16>(increment ? first + index : first), run[index], subChannel, lastCall && index == run.size() - 1});
+        }};
+
+        // Macro arguments depend on every individual call, runs that extend into the macro methods are rare enough to not be worth splitting
+        auto end{increment ? method + arguments.size() : method + 1UL};
+        if (end > constant::Maxwell3DRegisterCounter) {
+            callIndividually(method, arguments);
+            return;
+        }
+
+        auto sideEffect{std::lower_bound(SideEffectRegisters.begin(), SideEffectRegisters.end(), method)};
+        if (!increment) {
+            // Only the final write to a register without side effects is observable, the rest are filtered
+            if (sideEffect != SideEffectRegisters.end() && *sideEffect == method) {
+                callIndividually(method, arguments);
+            } else if (RegisterStateBlocks[method] & AlwaysDirtyFlag) {
+                // Stream registers consume every word that is written to them, such as inline constant buffer data, so none of the writes can be dropped
+                for (auto argument : arguments)
+                    WriteRegister(method, argument, false);
+            } else {
+                filteredMethodCount += arguments.size() - 1;
+                WriteRegisters(method, arguments.last(1));
+            }
+            return;
+        }
+
+        // The run is split at every register with side effects, everything prior to such a register is written before it's handled as it may depend on those values
+        for (; sideEffect != SideEffectRegisters.end() && *sideEffect < end; sideEffect++) {
+            auto runLength{static_cast<size_t>(*sideEffect - method)};
+            WriteRegisters(method, arguments.first(runLength));
+
+            CallMethod(MethodParams{*sideEffect, arguments[runLength], subChannel, lastCall && runLength == arguments.size() - 1});
+            method = static_cast<u16>(*sideEffect + 1);
+            arguments = arguments.subspan(runLength + 1);
+        }
+
+        WriteRegisters(method, arguments);
+    }
+
+    void Maxwell3D::WriteRegisters(u16 method, std::span<const u32> arguments) {
+        auto shadowRamControl{shadowRegisters.mme.shadowRamControl};
+        auto writeIndividually{[this](u16 first, std::span<const u32> run) {
+            for (size_t index{}; index < run.size(); index++) {
+                auto argument{run[index]};
+                WriteRegister(static_cast<u32>(first + index), argument, false);
+            }
+        }};
+
+        // Filtering and replaying depend on the shadowed value of every register, so no register can be copied in bulk
+        if (shadowRamControl == Registers::MmeShadowRamControl::MethodTrackWithFilter || shadowRamControl == Registers::MmeShadowRamControl::MethodReplay) {
+            writeIndividually(method, arguments);
+            return;
+        }
+
+        // Registers outside of state blocks don't need to be compared for dirty tracking, so runs of them are copied directly
+        while (!arguments.empty()) {
+            auto run{arguments.first(std::min<size_t>(RegisterRunLengths[method], arguments.size()))};
+            if (RegisterStateBlocks[method]) {
+                writeIndividually(method, run);
+            } else {
+                std::memcpy(registers.raw.data() + method, run.data(), run.size_bytes());
+                if (shadowRamControl == Registers::MmeShadowRamControl::MethodTrack)
+                    std::memcpy(shadowRegisters.raw.data() + method, run.data(), run.size_bytes());
+            }
+
+            method = static_cast<u16>(method + run.size());
+            arguments = arguments.subspan(run.size());
+        }
+    }
+
+    bool Maxwell3D::WriteRegister(u32 method, u32 &argument, bool sideEffect) {
+        auto blocks{RegisterStateBlocks[method]};
+
+        // The shadow RAM control register itself is never shadowed, otherwise replaying would be impossible to leave
+        if (method != MAXWELL3D_OFFSET(mme.shadowRamControl)) {
+            switch (shadowRegisters.mme.shadowRamControl) {
+                case Registers::MmeShadowRamControl::MethodTrackWithFilter:
+                    // Stream registers are never filtered as a repeated word is still new data
+                    if (!sideEffect && !(blocks & AlwaysDirtyFlag) && shadowRegisters.raw[method] == argument) {
+                        filteredMethodCount++;
+                        return false;
+                    }
+                    [[fallthrough]];
+                case Registers::MmeShadowRamControl::MethodTrack:
+                    shadowRegisters.raw[method] = argument;
+                    break;
+                case Registers::MmeShadowRamControl::MethodReplay:
+                    argument = shadowRegisters.raw[method];
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        auto &value{registers.raw[method]};
+        if (value == argument && !(blocks & AlwaysDirtyFlag)) {
+            if (sideEffect)
+                return true;
+
+            filteredMethodCount++;
+            return false;
+        }
+
+        value = argument;
+        dirtyRegisters.set(method);
+        dirtyBlocks |= blocks & ~AlwaysDirtyFlag;
+        return true;
+    }
+
+    void Maxwell3D::ClearDirty(StateBlock block) {
+        static const auto blockRegisters{[] {
+            std::array<std::bitset<constant::Maxwell3DRegisterCounter>, constant::Maxwell3DStateBlockCount> masks;
+            for (const auto &range : StateBlockRanges)
+                for (u16 offset{range.offset}; offset < range.offset + range.size; offset++)
+                    masks[static_cast<size_t>(range.block)].set(offset);
+            return masks;
+        }()};
+
+        dirtyBlocks.reset(static_cast<size_t>(block));
+        dirtyRegisters &= ~blockRegisters[static_cast<size_t>(block)];
+    }
+
     void Maxwell3D::HandleSemaphoreCounterOperation() {
         switch (registers.semaphore.info.counterType) {
             case Registers::SemaphoreInfo::CounterType::Zero:
@@ -151,14 +362,9 @@ namespace skyline::gpu::engine {
     }
 
     void Maxwell3D::WriteSemaphoreResult(u64 result) {
-        struct FourWordResult {
-            u64 value;
-            u64 timestamp;
-        };
-
         switch (registers.semaphore.info.structureSize) {
             case Registers::SemaphoreInfo::StructureSize::OneWord:
-                state.gpu->memoryManager.Write<u32>(static_cast<u32>(result), registers.semaphore.address.Pack());
+                semaphoreWrites.push_back(SemaphoreWrite{registers.semaphore.address.Pack(), result, 0, false});
                 break;
             case Registers::SemaphoreInfo::StructureSize::FourWords: {
                 // Convert the current nanosecond time to GPU ticks
@@ -168,9 +374,48 @@ namespace skyline::gpu::engine {
                 u64 nsTime = util::GetTimeNs();
                 u64 timestamp = (nsTime / NsToTickDenominator) * NsToTickNumerator + ((nsTime % NsToTickDenominator) * NsToTickNumerator) / NsToTickDenominator;
 
-                state.gpu->memoryManager.Write<FourWordResult>(FourWordResult{result, timestamp}, registers.semaphore.address.Pack());
+                semaphoreWrites.push_back(SemaphoreWrite{registers.semaphore.address.Pack(), result, timestamp, true});
                 break;
             }
         }
     }
+
+    void Maxwell3D::FlushSemaphores() {
+        if (semaphoreWrites.empty())
+            return;
+
+        struct FourWordResult {
+            u64 value;
+            u64 timestamp;
+        };
+
+        auto &memoryManager{state.gpu->memoryManager};
+        u64 runAddress{}; // The address of the run of coalesced writes in semaphoreWriteBuffer
+        auto flushRun{[&]() {
+            if (!semaphoreWriteBuffer.empty())
+                memoryManager.Write(semaphoreWriteBuffer.data(), runAddress, semaphoreWriteBuffer.size());
+            semaphoreWriteBuffer.clear();
+        }};
+
+        for (const auto &write : semaphoreWrites) {
+            FourWordResult result{write.value, write.timestamp};
+            auto size{write.fourWords ? sizeof(FourWordResult) : sizeof(u32)};
+
+            // A write is only coalesced into the run if it overlaps or directly follows it in the same page, this retains the order of writes to any single address
+            auto runEnd{runAddress + semaphoreWriteBuffer.size()};
+            bool coalesce{!semaphoreWriteBuffer.empty() && write.address >= runAddress && write.address <= runEnd && util::AlignDown(write.address + size - 1, constant::GpuPageSize) == util::AlignDown(runAddress, constant::GpuPageSize)};
+            if (!coalesce) {
+                flushRun();
+                runAddress = write.address;
+            }
+
+            auto offset{write.address - runAddress};
+            if (offset + size > semaphoreWriteBuffer.size())
+                semaphoreWriteBuffer.resize(offset + size);
+            std::memcpy(semaphoreWriteBuffer.data() + offset, &result, size);
+        }
+
+        flushRun();
+        semaphoreWrites.clear();
+    }
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <common.h>
 #include <gpu/texture.h>
 #include <gpu/macro_interpreter.h>
@@ -14,6 +15,7 @@
 namespace skyline {
     namespace constant {
         constexpr u32 Maxwell3DRegisterCounter = 0xE00; //!< The number of Maxwell 3D registers
+        constexpr u8 Maxwell3DStateBlockCount = 7; //!< The number of state blocks the Maxwell 3D registers are grouped into for change tracking
     }
 
     namespace gpu::engine {
@@ -31,10 +33,43 @@ namespace skyline {
 
             MacroInterpreter macroInterpreter;
 
+            std::bitset<constant::Maxwell3DStateBlockCount> dirtyBlocks; //!< The state blocks which contain a register that has changed since they were last cleared, this is indexed by StateBlock
+
+            /**
+             * @brief Writes a value to a register through the shadow RAM and marks it as dirty if the value has changed
+             * @param argument The value to write, this is replaced with the shadowed value when replaying
+             * @param sideEffect If the register triggers an action when written to, such writes are never filtered
+             * @note Writes to registers that stream data, such as inline constant buffer updates, are never filtered either
+             * @return If the write had any effect, writes that don't are filtered and shouldn't be handled any further
+             */
+            bool WriteRegister(u32 method, u32 &argument, bool sideEffect);
+
+            /**
+             * @brief A semaphore release or report result that hasn't been written to guest memory yet
+             */
+            struct SemaphoreWrite {
+                u64 address; //!< The address in the GPU address space the result is written to
+                u64 value;
+                u64 timestamp;
+                bool fourWords; //!< If the value is written alongside a timestamp, otherwise only the lower 32-bits of the value are written
+            };
+
+            std::vector<SemaphoreWrite> semaphoreWrites; //!< The pending semaphore writes in the order they were issued, these are flushed at syncpoint increments and at the end of command processing
+            std::vector<u8> semaphoreWriteBuffer; //!< A reused buffer which holds the contents of a run of coalesced semaphore writes
+
             void HandleSemaphoreCounterOperation();
 
+            /**
+             * @brief Queues a semaphore result to be written to guest memory on the next flush
+             */
             void WriteSemaphoreResult(u64 result);
 
+            /**
+             * @brief Writes a run of arguments to consecutive registers which don't have any side effects
+             * @note Only registers in state blocks are compared and marked dirty, the rest are copied in bulk
+             */
+            void WriteRegisters(u16 method, std::span<const u32> arguments);
+
           public:
             /**
             * @brief This holds the Maxwell3D engine's register space
@@ -564,6 +599,23 @@ namespace skyline {
             Registers registers{}; //!< The maxwell 3D register space
             Registers shadowRegisters{}; //!< The shadow registers, their function is controlled by the 'shadowRamControl' register
 
+            /**
+             * @brief The groups of registers that are tracked for changes together, these correspond to the pipeline state a renderer has to update before a draw
+             */
+            enum class StateBlock : u8 {
+                Viewport, //!< The viewport transforms and viewports
+                Scissor, //!< The scissor rectangles
+                Blend, //!< The blend state and color write masks of all render targets
+                Depth, //!< The depth and stencil test state
+                VertexAttributes, //!< The vertex attribute formats and vertex streams
+                RenderTargets, //!< The color and depth render targets
+                ConstantBuffers, //!< The constant buffer selector, inline constant buffer updates and bindings
+            };
+            static_assert(static_cast<u8>(StateBlock::ConstantBuffers) + 1 == constant::Maxwell3DStateBlockCount);
+
+            std::bitset<constant::Maxwell3DRegisterCounter> dirtyRegisters; //!< The registers in state blocks that were written with a different value since they were last cleared
+            u64 filteredMethodCount{}; //!< The amount of register writes that were dropped as they had no effect
+
             std::array<u32, 0x10000> macroCode{}; //!< This is used to store GPU macros, the 256kb size is from Ryujinx
 
             Maxwell3D(const DeviceState &state);
@@ -574,6 +626,29 @@ namespace skyline {
             void ResetRegs();
 
             void CallMethod(MethodParams params);
+
+            /**
+             * @brief Writes all pending semaphore and report results to guest memory, this has to be done before the guest can observe the GPU passing a point in the command stream
+             * @note Consecutive writes to overlapping or adjacent addresses in the same GPU page are coalesced into a single write
+             */
+            void FlushSemaphores();
+
+            /**
+             * @return If any register in the state block has changed since it was last cleared
+             */
+            inline bool IsDirty(StateBlock block) const {
+                return dirtyBlocks.test(static_cast<size_t>(block));
+            }
+
+            /**
+             * @brief Clears the dirty state of a state block and all of its registers, this should be done after the state has been consumed
+             */
+            void ClearDirty(StateBlock block);
+
+            /**
+             * @brief Calls a run of methods, runs of plain registers are copied into the register space directly and only registers with side effects are handled individually
+             */
+            void CallMethods(u16 method, std::span<const u32> arguments, u32 subChannel, bool increment, bool lastCall);
         };
     }
 }
\ No newline at end of file
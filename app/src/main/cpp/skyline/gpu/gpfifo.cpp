@@ -42,7 +42,36 @@ namespace skyline::gpu::gpfifo {
         }
     }
 
-    void GPFIFO::Process(const std::vector<u32> &segment) {
+    void GPFIFO::SendRun(u16 method, std::span<const u32> arguments, u32 subChannel, bool increment, bool lastCall) {
+        // Engine bindings and GPFIFO methods are infrequent and aren't batched
+        if (method < constant::GpfifoRegisterCount) {
+            for (size_t index{}; index < arguments.size(); index++)
+                Send(MethodParams{static_cast<u16>(increment ? method + index : method), arguments[index], subChannel, lastCall && index == arguments.size() - 1});
+            return;
+        }
+
+        auto &engine{subchannels.at(subChannel)};
+        if (engine == nullptr)
+            throw exception("Calling method on unbound channel");
+
+        engine->CallMethods(method, arguments, subChannel, increment, lastCall);
+    }
+
+    std::span<const u32> GPFIFO::Fetch(const PushBuffer &pushBuffer) {
+        if (!pushBuffer.segment.empty() || !pushBuffer.gpEntry.size)
+            return pushBuffer.segment;
+
+        auto &memoryManager{state.gpu->memoryManager};
+        auto segment{memoryManager.GetHostSpan<const u32>(pushBuffer.GetAddress(), pushBuffer.gpEntry.size)};
+        if (!segment.empty())
+            return segment;
+
+        fetchBuffer.resize(pushBuffer.gpEntry.size);
+        memoryManager.Read<u32>(fetchBuffer, pushBuffer.GetAddress());
+        return fetchBuffer;
+    }
+
+    void GPFIFO::Process(std::span<const u32> segment) {
         for (auto entry = segment.begin(); entry != segment.end(); entry++) {
             // An entry containing all zeroes is a NOP, skip over it
             if (*entry == 0)
@@ -50,21 +79,34 @@ namespace skyline::gpu::gpfifo {
 
             auto methodHeader = reinterpret_cast<const PushBufferMethodHeader *>(&*entry);
 
+            // The arguments of a method header directly follow it, the iterator is advanced past them
+            auto arguments{[&]() {
+                u16 count{methodHeader->methodCount};
+                if (std::distance(entry, segment.end()) <= count)
+                    throw exception("Pushbuffer method header at 0x{:X} has {} arguments which extend past the end of the segment", std::distance(segment.begin(), entry) * sizeof(u32), count);
+
+                std::span<const u32> span(&*std::next(entry), count);
+                entry += count;
+                return span;
+            }};
+
             switch (methodHeader->secOp) {
                 case PushBufferMethodHeader::SecOp::IncMethod:
-                    for (u16 i{}; i < methodHeader->methodCount; i++)
-                        Send(MethodParams{static_cast<u16>(methodHeader->methodAddress + i), *++entry, methodHeader->methodSubChannel, i == methodHeader->methodCount - 1});
-
+                    if (methodHeader->methodCount)
+                        SendRun(methodHeader->methodAddress, arguments(), methodHeader->methodSubChannel, true, true);
                     break;
                 case PushBufferMethodHeader::SecOp::NonIncMethod:
-                    for (u16 i{}; i < methodHeader->methodCount; i++)
-                        Send(MethodParams{methodHeader->methodAddress, *++entry, methodHeader->methodSubChannel, i == methodHeader->methodCount - 1});
-
+                    if (methodHeader->methodCount)
+                        SendRun(methodHeader->methodAddress, arguments(), methodHeader->methodSubChannel, false, true);
                     break;
                 case PushBufferMethodHeader::SecOp::OneInc:
-                    for (u16 i{}; i < methodHeader->methodCount; i++)
-                        Send(MethodParams{static_cast<u16>(methodHeader->methodAddress + bool(i)), *++entry, methodHeader->methodSubChannel, i == methodHeader->methodCount - 1});
-
+                    if (methodHeader->methodCount) {
+                        // Only the first argument goes to the method, every following one goes to the next method
+                        auto run{arguments()};
+                        SendRun(methodHeader->methodAddress, run.first(1), methodHeader->methodSubChannel, false, run.size() == 1);
+                        if (run.size() > 1)
+                            SendRun(static_cast<u16>(methodHeader->methodAddress + 1), run.subspan(1), methodHeader->methodSubChannel, false, true);
+                    }
                     break;
                 case PushBufferMethodHeader::SecOp::ImmdDataMethod:
                     Send(MethodParams{methodHeader->methodAddress, methodHeader->immdData, methodHeader->methodSubChannel, true});
@@ -80,13 +122,12 @@ namespace skyline::gpu::gpfifo {
     void GPFIFO::Run() {
         std::lock_guard lock(pushBufferQueueLock);
         while (!pushBufferQueue.empty()) {
-            auto pushBuffer = pushBufferQueue.front();
-            if (pushBuffer.segment.empty())
-                pushBuffer.Fetch(state.gpu->memoryManager);
-
-            Process(pushBuffer.segment);
+            Process(Fetch(pushBufferQueue.front()));
             pushBufferQueue.pop();
         }
+
+        // Results of semaphores that weren't followed by a syncpoint increment need to be visible to the guest after the work is done
+        state.gpu->maxwell3D->FlushSemaphores();
     }
 
     void GPFIFO::Push(std::span<GpEntry> entries) {
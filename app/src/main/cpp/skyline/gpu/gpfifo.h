@@ -133,16 +133,20 @@ namespace skyline::gpu {
              */
             struct PushBuffer {
                 GpEntry gpEntry;
-                std::vector<u32> segment;
+                std::vector<u32> segment; //!< The contents of the pushbuffer, this is only filled in when it's fetched ahead of being processed
 
                 PushBuffer(const GpEntry &gpEntry, const vmm::MemoryManager &memoryManager, bool fetch) : gpEntry(gpEntry) {
-                    if (fetch)
-                        Fetch(memoryManager);
+                    if (fetch) {
+                        segment.resize(gpEntry.size);
+                        memoryManager.Read<u32>(segment, GetAddress());
+                    }
                 }
 
-                inline void Fetch(const vmm::MemoryManager &memoryManager) {
-                    segment.resize(gpEntry.size);
-                    memoryManager.Read<u32>(segment, (static_cast<u64>(gpEntry.getHi) << 32) | (static_cast<u64>(gpEntry.get) << 2));
+                /**
+                 * @return The address of the pushbuffer in the GPU address space
+                 */
+                inline u64 GetAddress() const {
+                    return (static_cast<u64>(gpEntry.getHi) << 32) | (static_cast<u64>(gpEntry.get) << 2);
                 }
             };
 
@@ -151,17 +155,30 @@ namespace skyline::gpu {
             std::array<std::shared_ptr<engine::Engine>, 8> subchannels;
             std::queue<PushBuffer> pushBufferQueue;
             skyline::Mutex pushBufferQueueLock; //!< This is used to lock pushbuffer queue insertions as the GPU runs on a seperate thread
+            std::vector<u32> fetchBuffer; //!< A reused buffer which holds the contents of pushbuffers that can't be accessed in place
+
+            /**
+             * @brief Fetches the contents of a pushbuffer, this is a span directly over guest memory when the pushbuffer is contiguous in host memory
+             * @return A span over the pushbuffer, it's only valid till the next call to this function
+             */
+            std::span<const u32> Fetch(const PushBuffer &pushBuffer);
 
             /**
              * @brief Processes a pushbuffer segment, calling methods as needed
              */
-            void Process(const std::vector<u32> &segment);
+            void Process(std::span<const u32> segment);
 
             /**
              * @brief This sends a method call to the GPU hardware
              */
             void Send(MethodParams params);
 
+            /**
+             * @brief This sends a run of method calls with consecutive arguments to the GPU hardware, the engine bound to the subchannel receives the run as a block
+             * @param increment If the method is incremented after every argument, otherwise all arguments are sent to the same method
+             */
+            void SendRun(u16 method, std::span<const u32> arguments, u32 subChannel, bool increment, bool lastCall);
+
           public:
             GPFIFO(const DeviceState &state) : state(state), gpfifoEngine(state) {}
 
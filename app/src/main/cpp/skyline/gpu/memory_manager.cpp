@@ -2,6 +2,7 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <kernel/types/KProcess.h>
+#include <gpu.h>
 #include "memory_manager.h"
 
 namespace skyline::gpu::vmm {
@@ -116,7 +117,11 @@ namespace skyline::gpu::vmm {
         chunk.size = size;
         chunk.state = ChunkState::Mapped;
 
-        return InsertChunk(chunk);
+        auto gpuAddress{InsertChunk(chunk)};
+        if (state.gpu && state.gpu->recorder)
+            state.gpu->recorder->RecordMap(gpuAddress, size);
+
+        return gpuAddress;
     }
 
     u64 MemoryManager::MapFixed(u64 address, u64 cpuAddress, u64 size) {
@@ -125,7 +130,11 @@ namespace skyline::gpu::vmm {
 
         size = util::AlignUp(size, constant::GpuPageSize);
 
-        return InsertChunk(ChunkDescriptor(address, size, cpuAddress, ChunkState::Mapped));
+        auto gpuAddress{InsertChunk(ChunkDescriptor(address, size, cpuAddress, ChunkState::Mapped))};
+        if (state.gpu && state.gpu->recorder)
+            state.gpu->recorder->RecordMap(gpuAddress, size);
+
+        return gpuAddress;
     }
 
     bool MemoryManager::Unmap(u64 address) {
@@ -142,19 +151,33 @@ namespace skyline::gpu::vmm {
         chunk->state = ChunkState::Reserved;
         chunk->cpuAddress = 0;
 
+        if (state.gpu && state.gpu->recorder)
+            state.gpu->recorder->RecordUnmap(address);
+
         return true;
     }
 
+    u8 *MemoryManager::GetHostPointer(u64 address, u64 size) const {
+        auto chunk = std::upper_bound(chunkList.begin(), chunkList.end(), address, [](const u64 address, const ChunkDescriptor &chunk) -> bool {
+            return address < chunk.address;
+        });
+
+        // Only a region inside a single mapped chunk is guaranteed to be contiguous in the CPU address space
+        if (chunk == chunkList.begin() || (--chunk)->state != ChunkState::Mapped || (address + size) > (chunk->address + chunk->size))
+            return nullptr;
+
+        return state.process->GetHostRegion(chunk->cpuAddress + (address - chunk->address), size);
+    }
+
     void MemoryManager::Read(u8 *destination, u64 address, u64 size) const {
         auto chunk = std::upper_bound(chunkList.begin(), chunkList.end(), address, [](const u64 address, const ChunkDescriptor &chunk) -> bool {
             return address < chunk.address;
         });
 
-        if (chunk == chunkList.end() || chunk->state != ChunkState::Mapped)
+        // The chunk containing the address is the one prior to the first chunk starting after it
+        if (chunk == chunkList.begin() || (--chunk)->state != ChunkState::Mapped)
             throw exception("Failed to read region in GPU address space: Address: 0x{:X}, Size: 0x{:X}", address, size);
 
-        chunk--;
-
         u64 initialSize{size};
         u64 chunkOffset{address - chunk->address};
         u64 readAddress{chunk->cpuAddress + chunkOffset};
@@ -180,11 +203,10 @@ namespace skyline::gpu::vmm {
             return address < chunk.address;
         });
 
-        if (chunk == chunkList.end() || chunk->state != ChunkState::Mapped)
+        // The chunk containing the address is the one prior to the first chunk starting after it
+        if (chunk == chunkList.begin() || (--chunk)->state != ChunkState::Mapped)
             throw exception("Failed to write region in GPU address space: Address: 0x{:X}, Size: 0x{:X}", address, size);
 
-        chunk--;
-
         u64 initialSize{size};
         u64 chunkOffset{address - chunk->address};
         u64 writeAddress{chunk->cpuAddress + chunkOffset};
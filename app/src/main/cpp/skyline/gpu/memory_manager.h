@@ -104,6 +104,23 @@ namespace skyline {
              */
             bool Unmap(u64 address);
 
+            /**
+             * @brief Resolves a region of the GPU virtual address space to host memory, this allows it to be accessed in place without a copy
+             * @return A pointer to the region in host memory or nullptr if it isn't contiguous in host memory, in which case it has to be read
+             */
+            u8 *GetHostPointer(u64 address, u64 size) const;
+
+            /**
+             * @brief Resolves a region of the GPU virtual address space to a span over host memory
+             * @tparam T The type of span to return
+             * @return A span over the region or an empty span if it isn't contiguous in host memory
+             */
+            template<typename T>
+            std::span<T> GetHostSpan(u64 address, size_t count) const {
+                auto pointer{GetHostPointer(address, count * sizeof(T))};
+                return pointer ? std::span<T>(reinterpret_cast<T *>(pointer), count) : std::span<T>();
+            }
+
             void Read(u8 *destination, u64 address, u64 size) const;
 
             /**
@@ -4,5 +4,38 @@
 #include "input.h"
 
 namespace skyline::input {
-    Input::Input(const DeviceState &state) : state(state), kHid(std::make_shared<kernel::type::KSharedMemory>(state, NULL, sizeof(HidSharedMemory), memory::Permission(true, false, false))), hid(reinterpret_cast<HidSharedMemory *>(kHid->kernel.address)), npad(state, hid), touch(state, hid) {}
+    Input::Input(const DeviceState &state) : state(state), kHid(std::make_shared<kernel::type::KSharedMemory>(state, NULL, sizeof(HidSharedMemory), memory::Permission(true, false, false))), hid(reinterpret_cast<HidSharedMemory *>(kHid->kernel.address)), npad(state, hid), touch(state, hid) {
+        samplingThread = std::thread(&Input::SamplingThread, this);
+    }
+
+    Input::~Input() {
+        {
+            std::lock_guard lock(samplingLock);
+            samplingRunning = false;
+        }
+        samplingCondition.notify_one();
+        samplingThread.join();
+    }
+
+    void Input::SamplingThread() {
+        constexpr std::chrono::nanoseconds SamplingPeriod{constant::NsInSecond / constant::HidSamplingRate};
+        auto nextSample{std::chrono::steady_clock::now() + SamplingPeriod};
+
+        try {
+            while (true) {
+                {
+                    std::unique_lock lock(samplingLock);
+                    if (samplingCondition.wait_until(lock, nextSample, [this] { return !samplingRunning; }))
+                        break;
+                }
+
+                npad.UpdateSharedMemory();
+                touch.UpdateSharedMemory();
+
+                nextSample = std::max(nextSample + SamplingPeriod, std::chrono::steady_clock::now()); // We don't want to write a burst of samples after the thread has been stalled
+            }
+        } catch (const std::exception &e) {
+            state.logger->Error("Input: Sampling thread has encountered an exception: {}", e.what());
+        }
+    }
 }
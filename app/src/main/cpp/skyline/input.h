@@ -3,12 +3,17 @@
 
 #pragma once
 
+#include <condition_variable>
 #include "common.h"
 #include "kernel/types/KSharedMemory.h"
 #include "input/shared_mem.h"
 #include "input/npad.h"
 #include "input/touch.h"
 
+namespace skyline::constant {
+    constexpr u64 HidSamplingRate = 200; //!< The rate at which HID samples input and writes it into shared memory in Hz
+}
+
 namespace skyline::input {
     /**
      * @brief The Input class manages translating host input to guest input
@@ -16,6 +21,15 @@ namespace skyline::input {
     class Input {
       private:
         const DeviceState &state;
+        std::thread samplingThread; //!< The thread which writes the accumulated host input into HID Shared Memory at the sampling rate
+        std::mutex samplingLock; //!< This mutex is used alongside samplingCondition to wait for the next sample
+        std::condition_variable samplingCondition; //!< This is signalled when the sampling thread needs to be stopped
+        bool samplingRunning{true}; //!< If the sampling thread should keep running, this is guarded by samplingLock
+
+        /**
+         * @brief The entry point of the sampling thread, this writes a single entry for every controller and the touch-screen into HID Shared Memory every sampling period
+         */
+        void SamplingThread();
 
       public:
         std::shared_ptr<kernel::type::KSharedMemory> kHid; //!< The kernel shared memory object for HID Shared Memory
@@ -25,5 +39,7 @@ namespace skyline::input {
         TouchManager touch;
 
         Input(const DeviceState &state);
+
+        ~Input();
     };
 }
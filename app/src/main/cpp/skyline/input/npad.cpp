@@ -81,6 +81,13 @@ namespace skyline::input {
         }
     }
 
+    void NpadManager::UpdateSharedMemory() {
+        std::lock_guard guard(mutex);
+
+        for (auto &npad : npads)
+            npad.UpdateSharedMemory();
+    }
+
     void NpadManager::Activate() {
         std::lock_guard guard(mutex);
 
@@ -74,6 +74,11 @@ namespace skyline::input {
          */
         void Update();
 
+        /**
+         * @brief This writes a single sample of the accumulated input state of every NPad into HID Shared Memory
+         */
+        void UpdateSharedMemory();
+
         /**
          * @brief This activates the mapping between guest controllers -> players, a call to this is required for function
          */
@@ -27,6 +27,8 @@ namespace skyline::input {
 
         section = {};
         controllerInfo = nullptr;
+        controllerState = {};
+        defaultState = {};
 
         connectionState = {.connected = true};
 
@@ -142,11 +144,8 @@ namespace skyline::input {
         type = newType;
         controllerInfo = &GetControllerInfo();
 
-        GetNextEntry(*controllerInfo);
-        GetNextEntry(section.defaultController);
-        globalTimestamp++;
-
-        updateEvent->Signal();
+        UpdateSharedMemory();
+        styleUpdated = true;
     }
 
     void NpadDevice::Disconnect() {
@@ -155,14 +154,17 @@ namespace skyline::input {
 
         section = {};
         globalTimestamp = 0;
+        controllerState = {};
+        defaultState = {};
 
         index = -1;
         partnerIndex = -1;
 
         type = NpadControllerType::None;
+        connectionState = {};
         controllerInfo = nullptr;
 
-        updateEvent->Signal();
+        styleUpdated = true;
     }
 
     NpadControllerInfo &NpadDevice::GetControllerInfo() {
@@ -203,16 +205,38 @@ namespace skyline::input {
         return entry;
     }
 
-    void NpadDevice::SetButtonState(NpadButton mask, bool pressed) {
+    void NpadDevice::UpdateSharedMemory() {
+        if (styleUpdated) {
+            updateEvent->Signal();
+            styleUpdated = false;
+        }
+
         if (!connectionState.connected)
             return;
 
-        auto &entry = GetNextEntry(*controllerInfo);
+        auto writeEntry{[this](NpadControllerInfo &info, const NpadInputState &input) {
+            auto &entry = GetNextEntry(info);
+            entry.buttons = input.buttons;
+            entry.leftX = input.leftX;
+            entry.leftY = input.leftY;
+            entry.rightX = input.rightX;
+            entry.rightY = input.rightY;
+        }};
+
+        writeEntry(*controllerInfo, controllerState);
+        writeEntry(section.defaultController, defaultState);
+        globalTimestamp++;
+    }
+
+    void NpadDevice::SetButtonState(NpadButton mask, bool pressed) {
+        std::lock_guard guard(manager.mutex);
+        if (!connectionState.connected)
+            return;
 
         if (pressed)
-            entry.buttons.raw |= mask.raw;
+            controllerState.buttons.raw |= mask.raw;
         else
-            entry.buttons.raw &= ~mask.raw;
+            controllerState.buttons.raw &= ~mask.raw;
 
         if (manager.orientation == NpadJoyOrientation::Horizontal && (type == NpadControllerType::JoyconLeft || type == NpadControllerType::JoyconRight)) {
             NpadButton orientedMask{};
@@ -247,109 +271,102 @@ namespace skyline::input {
             mask = orientedMask;
         }
 
-        auto &defaultEntry = GetNextEntry(section.defaultController);
         if (pressed)
-            defaultEntry.buttons.raw |= mask.raw;
+            defaultState.buttons.raw |= mask.raw;
         else
-            defaultEntry.buttons.raw &= ~mask.raw;
-
-        globalTimestamp++;
+            defaultState.buttons.raw &= ~mask.raw;
     }
 
     void NpadDevice::SetAxisValue(NpadAxisId axis, i32 value) {
+        std::lock_guard guard(manager.mutex);
         if (!connectionState.connected)
             return;
 
-        auto &controllerEntry = GetNextEntry(*controllerInfo);
-        auto &defaultEntry = GetNextEntry(section.defaultController);
-
         constexpr i16 threshold = std::numeric_limits<i16>::max() / 2; // A 50% deadzone for the stick buttons
 
         if (manager.orientation == NpadJoyOrientation::Vertical || (type != NpadControllerType::JoyconLeft && type != NpadControllerType::JoyconRight)) {
             switch (axis) {
                 case NpadAxisId::LX:
-                    controllerEntry.leftX = value;
-                    defaultEntry.leftX = value;
+                    controllerState.leftX = value;
+                    defaultState.leftX = value;
 
-                    controllerEntry.buttons.leftStickLeft = controllerEntry.leftX <= -threshold;
-                    defaultEntry.buttons.leftStickLeft = controllerEntry.buttons.leftStickLeft;
+                    controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
+                    defaultState.buttons.leftStickLeft = controllerState.buttons.leftStickLeft;
 
-                    controllerEntry.buttons.leftStickRight = controllerEntry.leftX >= threshold;
-                    defaultEntry.buttons.leftStickRight = controllerEntry.buttons.leftStickRight;
+                    controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
+                    defaultState.buttons.leftStickRight = controllerState.buttons.leftStickRight;
                     break;
                 case NpadAxisId::LY:
-                    controllerEntry.leftY = value;
-                    defaultEntry.leftY = value;
+                    controllerState.leftY = value;
+                    defaultState.leftY = value;
 
-                    defaultEntry.buttons.leftStickUp = controllerEntry.buttons.leftStickUp;
-                    controllerEntry.buttons.leftStickUp = controllerEntry.leftY >= threshold;
+                    controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
+                    defaultState.buttons.leftStickUp = controllerState.buttons.leftStickUp;
 
-                    controllerEntry.buttons.leftStickDown = controllerEntry.leftY <= -threshold;
-                    defaultEntry.buttons.leftStickDown = controllerEntry.buttons.leftStickDown;
+                    controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
+                    defaultState.buttons.leftStickDown = controllerState.buttons.leftStickDown;
                     break;
                 case NpadAxisId::RX:
-                    controllerEntry.rightX = value;
-                    defaultEntry.rightX = value;
+                    controllerState.rightX = value;
+                    defaultState.rightX = value;
 
-                    controllerEntry.buttons.rightStickLeft = controllerEntry.rightX <= -threshold;
-                    defaultEntry.buttons.rightStickLeft = controllerEntry.buttons.rightStickLeft;
+                    controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
+                    defaultState.buttons.rightStickLeft = controllerState.buttons.rightStickLeft;
 
-                    controllerEntry.buttons.rightStickRight = controllerEntry.rightX >= threshold;
-                    defaultEntry.buttons.rightStickRight = controllerEntry.buttons.rightStickRight;
+                    controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
+                    defaultState.buttons.rightStickRight = controllerState.buttons.rightStickRight;
                     break;
                 case NpadAxisId::RY:
-                    controllerEntry.rightY = value;
-                    defaultEntry.rightY = value;
+                    controllerState.rightY = value;
+                    defaultState.rightY = value;
 
-                    controllerEntry.buttons.rightStickUp = controllerEntry.rightY >= threshold;
-                    defaultEntry.buttons.rightStickUp = controllerEntry.buttons.rightStickUp;
+                    controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
+                    defaultState.buttons.rightStickUp = controllerState.buttons.rightStickUp;
 
-                    controllerEntry.buttons.rightStickDown = controllerEntry.rightY <= -threshold;
-                    defaultEntry.buttons.rightStickDown = controllerEntry.buttons.rightStickDown;
+                    controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
+                    defaultState.buttons.rightStickDown = controllerState.buttons.rightStickDown;
                     break;
             }
         } else {
             switch (axis) {
                 case NpadAxisId::LX:
-                    controllerEntry.leftY = value;
-                    controllerEntry.buttons.leftStickUp = controllerEntry.leftY >= threshold;
-                    controllerEntry.buttons.leftStickDown = controllerEntry.leftY <= -threshold;
+                    controllerState.leftY = value;
+                    controllerState.buttons.leftStickUp = controllerState.leftY >= threshold;
+                    controllerState.buttons.leftStickDown = controllerState.leftY <= -threshold;
 
-                    defaultEntry.leftX = value;
-                    defaultEntry.buttons.leftStickLeft = defaultEntry.leftX <= -threshold;
-                    defaultEntry.buttons.leftStickRight = defaultEntry.leftX >= threshold;
+                    defaultState.leftX = value;
+                    defaultState.buttons.leftStickLeft = defaultState.leftX <= -threshold;
+                    defaultState.buttons.leftStickRight = defaultState.leftX >= threshold;
                     break;
                 case NpadAxisId::LY:
-                    controllerEntry.leftX = -value;
-                    controllerEntry.buttons.leftStickLeft = controllerEntry.leftX <= -threshold;
-                    controllerEntry.buttons.leftStickRight = controllerEntry.leftX >= threshold;
+                    controllerState.leftX = -value;
+                    controllerState.buttons.leftStickLeft = controllerState.leftX <= -threshold;
+                    controllerState.buttons.leftStickRight = controllerState.leftX >= threshold;
 
-                    defaultEntry.leftY = value;
-                    defaultEntry.buttons.leftStickUp = defaultEntry.leftY >= threshold;
-                    defaultEntry.buttons.leftStickDown = defaultEntry.leftY <= -threshold;
+                    defaultState.leftY = value;
+                    defaultState.buttons.leftStickUp = defaultState.leftY >= threshold;
+                    defaultState.buttons.leftStickDown = defaultState.leftY <= -threshold;
                     break;
                 case NpadAxisId::RX:
-                    controllerEntry.rightY = value;
-                    controllerEntry.buttons.rightStickUp = controllerEntry.rightY >= threshold;
-                    controllerEntry.buttons.rightStickDown = controllerEntry.rightY <= -threshold;
+                    controllerState.rightY = value;
+                    controllerState.buttons.rightStickUp = controllerState.rightY >= threshold;
+                    controllerState.buttons.rightStickDown = controllerState.rightY <= -threshold;
 
-                    defaultEntry.rightX = value;
-                    defaultEntry.buttons.rightStickLeft = defaultEntry.rightX <= -threshold;
-                    defaultEntry.buttons.rightStickRight = defaultEntry.rightX >= threshold;
+                    defaultState.rightX = value;
+                    defaultState.buttons.rightStickLeft = defaultState.rightX <= -threshold;
+                    defaultState.buttons.rightStickRight = defaultState.rightX >= threshold;
                     break;
                 case NpadAxisId::RY:
-                    controllerEntry.rightX = -value;
-                    controllerEntry.buttons.rightStickLeft = controllerEntry.rightX <= -threshold;
-                    controllerEntry.buttons.rightStickRight = controllerEntry.rightX >= threshold;
+                    controllerState.rightX = -value;
+                    controllerState.buttons.rightStickLeft = controllerState.rightX <= -threshold;
+                    controllerState.buttons.rightStickRight = controllerState.rightX >= threshold;
 
-                    defaultEntry.rightY = value;
-                    defaultEntry.buttons.rightStickUp = defaultEntry.rightY >= threshold;
-                    defaultEntry.buttons.rightStickDown = defaultEntry.rightY <= -threshold;
+                    defaultState.rightY = value;
+                    defaultState.buttons.rightStickUp = defaultState.rightY >= threshold;
+                    defaultState.buttons.rightStickDown = defaultState.rightY <= -threshold;
                     break;
             }
         }
-
-        globalTimestamp++;
     }
 
     struct VibrationInfo {
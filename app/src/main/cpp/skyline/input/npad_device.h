@@ -111,6 +111,17 @@ namespace skyline::input {
     };
     static_assert(sizeof(NpadVibrationValue) == 0x10);
 
+    /**
+     * @brief The input state of a controller that is accumulated from host events between samples
+     */
+    struct NpadInputState {
+        NpadButton buttons;
+        i32 leftX;
+        i32 leftY;
+        i32 rightX;
+        i32 rightY;
+    };
+
     class NpadManager;
 
     /**
@@ -122,6 +133,9 @@ namespace skyline::input {
         NpadSection &section; //!< The section in HID shared memory for this controller
         NpadControllerInfo *controllerInfo; //!< The NpadControllerInfo for this controller's type
         u64 globalTimestamp{}; //!< An incrementing timestamp that's common across all sections
+        NpadInputState controllerState{}; //!< The accumulated input state in the layout of this controller's type
+        NpadInputState defaultState{}; //!< The accumulated input state in the layout of the default controller
+        bool styleUpdated{}; //!< If the style of this controller has changed since the last sample, updateEvent is signalled on the next sample
 
         /**
          * @brief This updates the headers and creates a new entry in HID Shared Memory
@@ -143,7 +157,7 @@ namespace skyline::input {
         std::optional<NpadVibrationValue> vibrationRight; //!< Vibration for the right Joy-Con (Handheld/Pair) or right LRA in a Pro-Controller
         NpadControllerType type{};
         NpadConnectionState connectionState{};
-        std::shared_ptr<kernel::type::KEvent> updateEvent; //!< This event is triggered on the controller's style changing
+        std::shared_ptr<kernel::type::KEvent> updateEvent; //!< This event is triggered on the first sample after the controller's style changing
 
         NpadDevice(NpadManager &manager, NpadSection &section, NpadId id);
 
@@ -173,10 +187,17 @@ namespace skyline::input {
          */
         void Disconnect();
 
+        /**
+         * @brief This writes the input state accumulated since the last sample into HID Shared Memory as a single entry in the controller and default sections
+         * @note The mutex of the NpadManager must be locked when this is called
+         */
+        void UpdateSharedMemory();
+
         /**
          * @brief This changes the state of buttons to the specified state
          * @param mask A bit-field mask of all the buttons to change
          * @param pressed If the buttons were pressed or released
+         * @note The change is only written into HID Shared Memory on the next sample
          */
         void SetButtonState(NpadButton mask, bool pressed);
 
@@ -184,6 +205,7 @@ namespace skyline::input {
          * @brief This sets the value of an axis to the specified value
          * @param axis The axis to set the value of
          * @param value The value to set
+         * @note The change is only written into HID Shared Memory on the next sample
          */
         void SetAxisValue(NpadAxisId axis, i32 value);
 
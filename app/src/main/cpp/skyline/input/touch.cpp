@@ -10,11 +10,22 @@ namespace skyline::input {
     }
 
     void TouchManager::Activate() {
-        activated = true;
-        SetState({});
+        {
+            std::lock_guard guard(mutex);
+            activated = true;
+            pointCount = 0;
+        }
+        UpdateSharedMemory();
     }
 
     void TouchManager::SetState(const std::span<TouchScreenPoint> &points) {
+        std::lock_guard guard(mutex);
+        pointCount = std::min(points.size(), constant::TouchPointCount);
+        std::copy(points.begin(), points.begin() + pointCount, this->points.begin());
+    }
+
+    void TouchManager::UpdateSharedMemory() {
+        std::lock_guard guard(mutex);
         if (!activated)
             return;
 
@@ -23,9 +34,9 @@ namespace skyline::input {
         auto& entry = section.entries[entryIndex];
         entry.globalTimestamp = lastEntry.globalTimestamp + 1;
         entry.localTimestamp = lastEntry.localTimestamp + 1;
-        entry.touchCount = points.size();
+        entry.touchCount = pointCount;
 
-        for (size_t i{}; i < points.size(); i++) {
+        for (size_t i{}; i < pointCount; i++) {
             const auto& host = points[i];
             auto& guest = entry.data[i];
             guest.index = i;
@@ -6,6 +6,10 @@
 #include <common.h>
 #include "shared_mem.h"
 
+namespace skyline::constant {
+    constexpr size_t TouchPointCount = 16; //!< The maximum amount of points that can be touched at once
+}
+
 namespace skyline::input {
     /*
      * @brief A description of a point being touched on the screen
@@ -26,8 +30,11 @@ namespace skyline::input {
     class TouchManager {
       private:
         const DeviceState &state;
-        bool activated{};
+        bool activated{}; //!< If the touch-screen is being sampled, this is guarded by mutex
         TouchScreenSection &section;
+        std::mutex mutex; //!< This mutex is used to synchronize access to the points between the host input and sampling threads
+        std::array<TouchScreenPoint, constant::TouchPointCount> points{}; //!< The points that were touched on the last host input event
+        size_t pointCount{}; //!< The amount of valid points in the points array
 
       public:
         /**
@@ -37,6 +44,15 @@ namespace skyline::input {
 
         void Activate();
 
+        /**
+         * @brief This sets the points which are currently being touched
+         * @note The points are only written into HID Shared Memory on the next sample
+         */
         void SetState(const std::span<TouchScreenPoint> &points);
+
+        /**
+         * @brief This writes a single sample of the touched points into HID Shared Memory
+         */
+        void UpdateSharedMemory();
     };
 }
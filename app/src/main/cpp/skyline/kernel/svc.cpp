@@ -572,6 +572,7 @@ namespace skyline::kernel::svc {
 
     void GetSystemTick(DeviceState &state) {
         u64 tick;
+        #if defined(__aarch64__)
         asm("STR X1, [SP, #-16]!\n\t"
             "MRS %0, CNTVCT_EL0\n\t"
             "MOV X1, #0xF800\n\t"
@@ -580,6 +581,11 @@ namespace skyline::kernel::svc {
             "MRS X1, CNTFRQ_EL0\n\t"
             "UDIV %0, %0, X1\n\t"
             "LDR X1, [SP], #16" : "=r"(tick));
+        #else
+        constexpr u64 TegraX1Frequency{19200000}; // The frequency of the Tegra X1's system counter
+        auto time{util::GetTimeNs()};
+        tick = (time / constant::NsInSecond) * TegraX1Frequency + ((time % constant::NsInSecond) * TegraX1Frequency) / constant::NsInSecond;
+        #endif
         state.ctx->registers.x0 = tick;
     }
 
@@ -8,6 +8,7 @@
 #include <nce/guest.h>
 #include <nce.h>
 #include <os.h>
+#include <profile.h>
 #include "KProcess.h"
 
 namespace skyline::kernel::type {
@@ -56,6 +57,8 @@ namespace skyline::kernel::type {
     }
 
     void KProcess::InitializeMemory() {
+        profile::ScopedTimer timer{profile::Stage::InitializeMemory};
+
         constexpr size_t DefHeapSize = 0x200000; // The default amount of heap
         heap = NewHandle<KPrivateMemory>(state.os->memory.heap.address, DefHeapSize, memory::Permission{true, true, false}, memory::states::Heap).item;
         threads[pid]->tls = GetTlsSlot();
@@ -107,6 +110,13 @@ namespace skyline::kernel::type {
         return (chunk && chunk->host) ? chunk->host + (address - chunk->address) : 0;
     }
 
+    u8 *KProcess::GetHostRegion(u64 address, size_t size) {
+        auto chunk = state.os->memory.GetChunk(address);
+        if (!chunk || !chunk->host || (address + size) > (chunk->address + chunk->size))
+            return nullptr;
+        return reinterpret_cast<u8 *>(chunk->host + (address - chunk->address));
+    }
+
     void KProcess::ReadMemory(void *destination, u64 offset, size_t size, bool forceGuest) {
         if (!forceGuest) {
             auto source = GetHostAddress(offset);
@@ -155,6 +155,13 @@ namespace skyline {
             */
             u64 GetHostAddress(u64 address);
 
+            /**
+            * @param address The guest address of the region
+            * @param size The size of the region in bytes
+            * @return A pointer to the region in host memory or nullptr if it isn't wholly contained in a single host mapping
+            */
+            u8 *GetHostRegion(u64 address, size_t size);
+
             /**
             * @tparam Type The type of the pointer to return
             * @param address The address on the guest
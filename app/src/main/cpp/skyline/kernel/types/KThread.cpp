@@ -39,7 +39,8 @@ namespace skyline::kernel::type {
         this->priority = priority;
         auto priorityValue = androidPriority.Rescale(switchPriority, priority);
 
-        if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), priorityValue) == -1)
+        // Raising the priority is refused without the nice rlimit Android grants to applications, the thread is left at its current priority in that case
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), priorityValue) == -1 && errno != EACCES && errno != EPERM)
             throw exception("Couldn't set process priority to {} for PID: {}", priorityValue, tid);
     }
 }
@@ -4,6 +4,7 @@
 #include <nce.h>
 #include <os.h>
 #include <kernel/memory.h>
+#include <profile.h>
 #include "loader.h"
 
 namespace skyline::loader {
@@ -24,6 +25,8 @@ namespace skyline::loader {
         u64 patchOffset = executable.data.offset + dataSize;
         std::vector<u32> patch = state.nce->PatchCode(executable.text.contents, base, patchOffset);
 
+        profile::ScopedTimer timer{profile::Stage::LoadExecutable};
+
         u64 patchSize = patch.size() * sizeof(u32);
         u64 padding = util::AlignUp(patchSize, PAGE_SIZE) - patchSize;
 
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <future>
 #include <nce.h>
 #include <os.h>
 #include <kernel/memory.h>
@@ -21,20 +22,24 @@ namespace skyline::loader {
         if (nsoFile == nullptr)
             throw exception("Cannot load an ExeFS that doesn't contain rtld");
 
-        auto loadInfo = NsoLoader::LoadNso(nsoFile, process, state);
-        u64 offset = loadInfo.size;
-        u64 base = loadInfo.base;
-
-        state.logger->Info("Loaded nso 'rtld' at 0x{:X}", base);
-
+        // Every NSO is read concurrently as they're independent of each other, they're loaded sequentially as the placement of an NSO depends on the size of the ones before it
+        std::vector<std::pair<std::string_view, std::future<Executable>>> nsos;
+        nsos.emplace_back("rtld", std::async(std::launch::async, &NsoLoader::ReadNso, nsoFile, std::cref(state)));
         for (const auto &nso : {"main", "subsdk0", "subsdk1", "subsdk2", "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"}) {
             nsoFile = exeFs->OpenFile(nso);
 
             if (nsoFile == nullptr)
                 continue;
 
-            loadInfo = NsoLoader::LoadNso(nsoFile, process, state, offset);
-            state.logger->Info("Loaded nso '{}' at 0x{:X}", nso, base + offset);
+            nsos.emplace_back(nso, std::async(std::launch::async, &NsoLoader::ReadNso, nsoFile, std::cref(state)));
+        }
+
+        u64 base{constant::BaseAddress};
+        u64 offset{};
+        for (auto &[name, nso] : nsos) {
+            auto executable{nso.get()};
+            auto loadInfo{NsoLoader::LoadNso(executable, process, state, offset)};
+            state.logger->Info("Loaded nso '{}' at 0x{:X}", name, base + offset);
             offset += loadInfo.size;
         }
 
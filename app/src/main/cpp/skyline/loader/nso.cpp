@@ -1,8 +1,11 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <future>
 #include <lz4.h>
+#include <mbedtls/sha256.h>
 #include <nce.h>
+#include <profile.h>
 #include <os.h>
 #include <kernel/memory.h>
 #include "nso.h"
@@ -16,22 +19,33 @@ namespace skyline::loader {
             throw exception("Invalid NSO magic! 0x{0:X}", magic);
     }
 
-    std::vector<u8> NsoLoader::GetSegment(const std::shared_ptr<vfs::Backing> &backing, const NsoSegmentHeader &segment, u32 compressedSize) {
-        std::vector<u8> outputBuffer(segment.decompressedSize);
+    void NsoLoader::ReadSegment(const std::shared_ptr<vfs::Backing> &backing, const NsoSegmentHeader &segment, u32 compressedSize, std::span<u8> output, const std::array<u8, 0x20> *hash) {
+        if (output.size() < segment.decompressedSize)
+            throw exception("NSO segment output buffer is too small: 0x{:X} < 0x{:X}", output.size(), segment.decompressedSize);
 
         if (compressedSize) {
             std::vector<u8> compressedBuffer(compressedSize);
-            backing->Read(compressedBuffer.data(), segment.fileOffset, compressedSize);
+            if (backing->Read(compressedBuffer.data(), segment.fileOffset, compressedSize) != compressedSize)
+                throw exception("NSO segment at 0x{:X} is truncated", segment.fileOffset);
 
-            LZ4_decompress_safe(reinterpret_cast<char *>(compressedBuffer.data()), reinterpret_cast<char *>(outputBuffer.data()), compressedSize, segment.decompressedSize);
+            auto decompressedSize{LZ4_decompress_safe(reinterpret_cast<char *>(compressedBuffer.data()), reinterpret_cast<char *>(output.data()), compressedSize, segment.decompressedSize)};
+            if (decompressedSize != segment.decompressedSize)
+                throw exception("Failed to decompress NSO segment at 0x{:X}: {}", segment.fileOffset, decompressedSize);
         } else {
-            backing->Read(outputBuffer.data(), segment.fileOffset, segment.decompressedSize);
+            if (backing->Read(output.data(), segment.fileOffset, segment.decompressedSize) != segment.decompressedSize)
+                throw exception("NSO segment at 0x{:X} is truncated", segment.fileOffset);
         }
 
-        return outputBuffer;
+        if (hash) {
+            std::array<u8, 0x20> segmentHash;
+            mbedtls_sha256_ret(output.data(), segment.decompressedSize, segmentHash.data(), 0);
+            if (segmentHash != *hash)
+                throw exception("NSO segment at 0x{:X} doesn't match its hash", segment.fileOffset);
+        }
     }
 
-    Loader::ExecutableLoadInfo NsoLoader::LoadNso(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> process, const DeviceState &state, size_t offset) {
+    Executable NsoLoader::ReadNso(const std::shared_ptr<vfs::Backing> &backing, const DeviceState &state) {
+        profile::ScopedTimer timer{profile::Stage::NsoDecompress};
         NsoHeader header{};
         backing->Read(&header);
 
@@ -39,22 +53,33 @@ namespace skyline::loader {
             throw exception("Invalid NSO magic! 0x{0:X}", header.magic);
 
         Executable nsoExecutable{};
+        bool verifyHashes{state.settings->GetBool("nso_hash_check", false)};
 
-        nsoExecutable.text.contents = GetSegment(backing, header.text, header.flags.textCompressed ? header.textCompressedSize : 0);
-        nsoExecutable.text.contents.resize(util::AlignUp(nsoExecutable.text.contents.size(), PAGE_SIZE));
-        nsoExecutable.text.offset = header.text.memoryOffset;
+        // Every segment is decompressed directly into its final page-aligned buffer, hashing a segment overlaps with the reading and decompression of the others
+        auto readSegment{[&](Executable::Segment &segment, const NsoSegmentHeader &segmentHeader, bool compressed, u32 compressedSize, bool hashed, const std::array<u8, 0x20> &hash) {
+            segment.contents.resize(util::AlignUp(segmentHeader.decompressedSize, PAGE_SIZE));
+            segment.offset = segmentHeader.memoryOffset;
+            ReadSegment(backing, segmentHeader, compressed ? compressedSize : 0, segment.contents, (verifyHashes && hashed) ? &hash : nullptr);
+        }};
 
-        nsoExecutable.ro.contents = GetSegment(backing, header.ro, header.flags.textCompressed ? header.textCompressedSize : 0);
-        nsoExecutable.ro.contents.resize(util::AlignUp(nsoExecutable.ro.contents.size(), PAGE_SIZE));
-        nsoExecutable.ro.offset = header.ro.memoryOffset;
-
-        nsoExecutable.data.contents = GetSegment(backing, header.data, header.flags.textCompressed ? header.textCompressedSize : 0);
-        nsoExecutable.data.contents.resize(util::AlignUp(nsoExecutable.data.contents.size(), PAGE_SIZE));
-        nsoExecutable.data.offset = header.data.memoryOffset;
+        auto ro{std::async(std::launch::async, [&] { readSegment(nsoExecutable.ro, header.ro, header.flags.roCompressed, header.roCompressedSize, header.flags.roHash, header.segmentHashes[1]); })};
+        auto data{std::async(std::launch::async, [&] { readSegment(nsoExecutable.data, header.data, header.flags.dataCompressed, header.dataCompressedSize, header.flags.dataHash, header.segmentHashes[2]); })};
+        readSegment(nsoExecutable.text, header.text, header.flags.textCompressed, header.textCompressedSize, header.flags.textHash, header.segmentHashes[0]);
+        ro.get();
+        data.get();
 
         nsoExecutable.bssSize = util::AlignUp(header.bssSize, PAGE_SIZE);
 
-        return LoadExecutable(process, state, nsoExecutable, offset);
+        return nsoExecutable;
+    }
+
+    Loader::ExecutableLoadInfo NsoLoader::LoadNso(Executable &executable, const std::shared_ptr<kernel::type::KProcess> process, const DeviceState &state, size_t offset) {
+        return LoadExecutable(process, state, executable, offset);
+    }
+
+    Loader::ExecutableLoadInfo NsoLoader::LoadNso(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> process, const DeviceState &state, size_t offset) {
+        auto nsoExecutable{ReadNso(backing, state)};
+        return LoadNso(nsoExecutable, process, state, offset);
     }
 
     void NsoLoader::LoadProcessData(const std::shared_ptr<kernel::type::KProcess> process, const DeviceState &state) {
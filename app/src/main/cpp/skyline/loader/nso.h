@@ -63,23 +63,40 @@ namespace skyline::loader {
             u64 dynstr; //!< The .rodata-relative offset of .dynstr
             u64 dynsym; //!< The .rodata-relative offset of .dynsym
 
-            u64 segmentHashes[3][4]; //!< The SHA256 checksums of the .text, .rodata and .data segments
+            std::array<std::array<u8, 0x20>, 3> segmentHashes; //!< The SHA256 checksums of the .text, .rodata and .data segments
         };
         static_assert(sizeof(NsoHeader) == 0x100);
 
         std::shared_ptr<vfs::Backing> backing; //!< The backing of the NSO loader
 
         /**
-         * @brief This reads the specified segment from the backing and decompresses it if needed
+         * @brief This reads the specified segment from the backing into a buffer and decompresses it if needed
          * @param segment The header of the segment to read
          * @param compressedSize The compressed size of the segment, 0 if the segment is not compressed
-         * @return A buffer containing the data of the requested segment
+         * @param output The buffer to write the segment into, this must be at least as large as the decompressed segment
+         * @param hash The SHA256 hash the segment is verified against after reading it, nullptr if it shouldn't be verified
          */
-        static std::vector<u8> GetSegment(const std::shared_ptr<vfs::Backing> &backing, const NsoSegmentHeader &segment, u32 compressedSize);
+        static void ReadSegment(const std::shared_ptr<vfs::Backing> &backing, const NsoSegmentHeader &segment, u32 compressedSize, std::span<u8> output, const std::array<u8, 0x20> *hash);
 
       public:
         NsoLoader(const std::shared_ptr<vfs::Backing> &backing);
 
+        /**
+         * @brief This reads all segments of an NSO, they're read, decompressed and verified concurrently
+         * @param backing The backing of the NSO
+         * @return An Executable containing the page-aligned segments of the NSO
+         */
+        static Executable ReadNso(const std::shared_ptr<vfs::Backing> &backing, const DeviceState &state);
+
+        /**
+         * @brief This loads an already read NSO into memory, offset by the given amount
+         * @param executable The executable returned by ReadNso
+         * @param process The process to load the NSO into
+         * @param offset The offset from the base address to place the NSO
+         * @return An ExecutableLoadInfo struct containing the load base and size
+         */
+        static ExecutableLoadInfo LoadNso(Executable &executable, const std::shared_ptr<kernel::type::KProcess> process, const DeviceState &state, size_t offset = 0);
+
         /**
          * @brief This loads an NSO into memory, offset by the given amount
          * @param backing The backing of the NSO
@@ -1,19 +1,20 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <sys/stat.h>
 #include "nca.h"
 #include "nsp.h"
 
 namespace skyline::loader {
-    NspLoader::NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore) : nsp(std::make_shared<vfs::PartitionFileSystem>(backing)) {
-        auto root{nsp->OpenDirectory("", {false, true})};
+    void NspLoader::ReadNcas(const std::shared_ptr<vfs::PartitionFileSystem> &pfs, const std::shared_ptr<crypto::KeyStore> &keyStore, const vfs::NCA *baseNca) {
+        auto root{pfs->OpenDirectory("", {false, true})};
 
         for (const auto &entry : root->Read()) {
             if (entry.name.substr(entry.name.find_last_of(".") + 1) != "nca")
                 continue;
 
             try {
-                auto nca{vfs::NCA(nsp->OpenFile(entry.name), keyStore)};
+                auto nca{vfs::NCA(pfs->OpenFile(entry.name), keyStore, baseNca)};
 
                 if (nca.contentType == vfs::NcaContentType::Program && nca.romFs != nullptr && nca.exeFs != nullptr)
                     programNca = std::move(nca);
@@ -25,12 +26,40 @@ namespace skyline::loader {
                 continue;
             }
         }
+    }
+
+    NspLoader::NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, const std::string &cachePath, const std::shared_ptr<vfs::Backing> &updateBacking) : nsp(std::make_shared<vfs::PartitionFileSystem>(backing)) {
+        ReadNcas(nsp, keyStore, nullptr);
 
         if (!programNca || !controlNca)
             throw exception("Incomplete NSP file");
 
+        if (updateBacking) {
+            // The program NCA of an update patches the RomFS of the base program NCA, any NCAs missing from the update are used from the base
+            std::optional<vfs::NCA> baseProgramNca, baseControlNca;
+            baseProgramNca.swap(programNca);
+            baseControlNca.swap(controlNca);
+
+            ReadNcas(std::make_shared<vfs::PartitionFileSystem>(updateBacking), keyStore, &*baseProgramNca);
+
+            if (!programNca)
+                programNca = std::move(baseProgramNca);
+            if (!controlNca)
+                controlNca = std::move(baseControlNca);
+        }
+
         romFs = programNca->romFs;
-        controlRomFs = std::make_shared<vfs::RomFileSystem>(controlNca->romFs);
+
+        // The RomFS index is keyed by the hash of the section so an updated title never uses a stale index
+        std::string indexPath;
+        if (!cachePath.empty() && (!mkdir(cachePath.c_str(), S_IRWXU) || errno == EEXIST)) {
+            indexPath = cachePath + "/";
+            for (auto byte : controlNca->romFsHash)
+                indexPath += fmt::format("{:02X}", byte);
+            indexPath += ".romfs_index";
+        }
+
+        controlRomFs = std::make_shared<vfs::RomFileSystem>(controlNca->romFs, indexPath);
         nacp = std::make_shared<vfs::NACP>(controlRomFs->OpenFile("control.nacp"));
     }
 
@@ -21,8 +21,18 @@ namespace skyline::loader {
         std::optional<vfs::NCA> programNca; //!< The main program NCA within the NSP
         std::optional<vfs::NCA> controlNca; //!< The main control NCA within the NSP
 
+        /**
+         * @brief Reads the program and control NCAs from a PFS0, replacing any that were read prior
+         * @param baseNca The program NCA which is patched by the NCAs in the PFS0, if any
+         */
+        void ReadNcas(const std::shared_ptr<vfs::PartitionFileSystem> &pfs, const std::shared_ptr<crypto::KeyStore> &keyStore, const vfs::NCA *baseNca);
+
       public:
-        NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore);
+        /**
+         * @param cachePath The path to a directory in which indices of the RomFS are persisted, an empty path disables persisting them
+         * @param updateBacking An NSP containing an update for the application, its NCAs are used instead of the base NCAs with the RomFS being patched
+         */
+        NspLoader(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, const std::string &cachePath = {}, const std::shared_ptr<vfs::Backing> &updateBacking = nullptr);
 
         std::vector<u8> GetIcon();
 
@@ -8,6 +8,7 @@
 #include "nce/guest.h"
 #include "nce/instructions.h"
 #include "kernel/svc.h"
+#include "profile.h"
 #include "nce.h"
 
 extern bool Halt;
@@ -210,6 +211,8 @@ namespace skyline {
     }
 
     std::vector<u32> NCE::PatchCode(std::vector<u8> &code, u64 baseAddress, i64 offset) {
+        profile::ScopedTimer timer{profile::Stage::PatchCode};
+
         constexpr u32 TpidrEl0 = 0x5E82;      // ID of TPIDR_EL0 in MRS
         constexpr u32 TpidrroEl0 = 0x5E83;    // ID of TPIDRRO_EL0 in MRS
         constexpr u32 CntfrqEl0 = 0x5F00;     // ID of CNTFRQ_EL0 in MRS
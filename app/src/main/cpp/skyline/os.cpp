@@ -7,13 +7,21 @@
 #include "loader/nca.h"
 #include "loader/nsp.h"
 #include "nce/guest.h"
+#include "gpu.h"
+#include "profile.h"
 #include "os.h"
 
 namespace skyline::kernel {
     OS::OS(std::shared_ptr<JvmManager> &jvmManager, std::shared_ptr<Logger> &logger, std::shared_ptr<Settings> &settings, const std::string &appFilesPath) : state(this, process, jvmManager, settings, logger), memory(state), serviceManager(state), appFilesPath(appFilesPath) {}
 
-    void OS::Execute(int romFd, loader::RomFormat romType) {
-        auto romFile{std::make_shared<vfs::OsBacking>(romFd)};
+    void OS::Execute(int romFd, loader::RomFormat romType, int updateFd) {
+        profile::BootProfile::Reset();
+
+        if (state.settings->GetBool("gpu_capture", false))
+            state.gpu->recorder = std::make_unique<gpu::capture::Recorder>(appFilesPath + "gpu_capture.bin", state.gpu->memoryManager);
+
+        auto romFile{std::make_shared<vfs::OsBacking>(romFd, false, vfs::Backing::Mode{true, false, false}, true)};
+        romFile->Advise(vfs::OsBacking::AccessPattern::Sequential);
         auto keyStore{std::make_shared<crypto::KeyStore>(appFilesPath)};
 
         if (romType == loader::RomFormat::NRO) {
@@ -23,16 +31,25 @@ namespace skyline::kernel {
         } else if (romType == loader::RomFormat::NCA) {
             state.loader = std::make_shared<loader::NcaLoader>(romFile, keyStore);
         } else if (romType == loader::RomFormat::NSP) {
-            state.loader = std::make_shared<loader::NspLoader>(romFile, keyStore);
+            std::shared_ptr<vfs::Backing> updateFile;
+            if (updateFd >= 0)
+                updateFile = std::make_shared<vfs::OsBacking>(updateFd, false, vfs::Backing::Mode{true, false, false}, true);
+            state.loader = std::make_shared<loader::NspLoader>(romFile, keyStore, appFilesPath + "romfs_index", updateFile);
         } else {
             throw exception("Unsupported ROM extension.");
         }
 
         process = CreateProcess(constant::BaseAddress, 0, constant::DefStackSize);
         state.loader->LoadProcessData(process, state);
+        romFile->Advise(vfs::OsBacking::AccessPattern::Random); // After loading the executables, the ROM is only accessed through RomFS which is read randomly
         process->InitializeMemory();
         process->threads.at(process->pid)->Start(); // The kernel itself is responsible for starting the main thread
 
+        // The boot profile is written to a file as well so it can be collected by automated runs to track startup time across builds
+        auto bootProfile{profile::BootProfile::Report()};
+        state.logger->Info("Boot profile: {}", bootProfile);
+        std::ofstream(appFilesPath + "boot_profile.json", std::ios::trunc) << bootProfile << '\n';
+
         state.nce->Execute();
     }
 
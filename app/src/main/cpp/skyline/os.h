@@ -36,8 +36,9 @@ namespace skyline::kernel {
          * @brief Execute a particular ROM file. This launches the main process and calls the NCE class to handle execution.
          * @param romFd A FD to the ROM file to execute
          * @param romType The type of the ROM file
+         * @param updateFd A FD to an NSP containing an update for the ROM or -1 if there is none, this is only used for NSPs
          */
-        void Execute(int romFd, loader::RomFormat romType);
+        void Execute(int romFd, loader::RomFormat romType, int updateFd = -1);
 
         /**
          * @brief Creates a new process
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "profile.h"
+
+namespace skyline::profile {
+    namespace {
+        constexpr std::array<std::string_view, StageCount> StageNames{
+            "key_store",
+            "nca_header",
+            "pfs0_index",
+            "romfs_index",
+            "nso_decompress",
+            "patch_code",
+            "load_executable",
+            "initialize_memory",
+        };
+    }
+
+    std::array<BootProfile::StageStatistics, StageCount> BootProfile::stages{};
+    std::atomic<u64> BootProfile::startTime{};
+
+    void BootProfile::Reset() {
+        for (auto &stage : stages) {
+            stage.count.store(0, std::memory_order_relaxed);
+            stage.totalNs.store(0, std::memory_order_relaxed);
+            stage.maxNs.store(0, std::memory_order_relaxed);
+        }
+        startTime.store(util::GetTimeNs(), std::memory_order_relaxed);
+    }
+
+    void BootProfile::Record(Stage stage, u64 durationNs) {
+        auto &statistics{stages[static_cast<size_t>(stage)]};
+        statistics.count.fetch_add(1, std::memory_order_relaxed);
+        statistics.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+
+        auto max{statistics.maxNs.load(std::memory_order_relaxed)};
+        while (durationNs > max && !statistics.maxNs.compare_exchange_weak(max, durationNs, std::memory_order_relaxed));
+    }
+
+    std::string BootProfile::Report() {
+        std::string report{fmt::format("{{\"elapsed_ns\":{},\"stages\":{{", util::GetTimeNs() - startTime.load(std::memory_order_relaxed))};
+        for (size_t index{}; index < StageCount; index++) {
+            auto &statistics{stages[index]};
+            report += fmt::format("{}\"{}\":{{\"count\":{},\"total_ns\":{},\"max_ns\":{}}}", index ? "," : "", StageNames[index], statistics.count.load(std::memory_order_relaxed), statistics.totalNs.load(std::memory_order_relaxed), statistics.maxNs.load(std::memory_order_relaxed));
+        }
+        report += "}}";
+        return report;
+    }
+}
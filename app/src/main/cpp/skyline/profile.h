@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include "common.h"
+
+namespace skyline::profile {
+    /**
+     * @brief This enumerates the stages of booting an application which are timed
+     */
+    enum class Stage : u8 {
+        KeyStore, //!< Parsing the key files
+        NcaHeader, //!< Decrypting the header of an NCA
+        Pfs0Index, //!< Reading the file table of a PFS0
+        RomFsIndex, //!< Building or loading the index of a RomFS
+        NsoDecompress, //!< Reading, decompressing and verifying the segments of an NSO
+        PatchCode, //!< Patching the code of an executable for NCE
+        LoadExecutable, //!< Mapping an executable into guest memory and copying it there
+        InitializeMemory, //!< Initializing the memory of the guest process
+    };
+    constexpr size_t StageCount{static_cast<size_t>(Stage::InitializeMemory) + 1};
+
+    /**
+     * @brief The BootProfile class accumulates the time spent in every stage of booting an application
+     * @note Recording a duration only consists of a few relaxed atomic operations, so this is always enabled
+     */
+    class BootProfile {
+      private:
+        /**
+         * @brief The accumulated timings of a single stage
+         */
+        struct StageStatistics {
+            std::atomic<u64> count; //!< The amount of times the stage occurred
+            std::atomic<u64> totalNs; //!< The sum of the durations of every occurrence, this can exceed the wall-clock time when the stage occurs on multiple threads at once
+            std::atomic<u64> maxNs; //!< The duration of the longest occurrence
+        };
+
+        static std::array<StageStatistics, StageCount> stages;
+        static std::atomic<u64> startTime; //!< The time at which the profile was last reset
+
+      public:
+        /**
+         * @brief Clears all recorded timings and starts a new profile, this should be done at the start of a boot
+         */
+        static void Reset();
+
+        /**
+         * @brief Adds a single occurrence of a stage to the profile
+         */
+        static void Record(Stage stage, u64 durationNs);
+
+        /**
+         * @return A single-line JSON object containing the time elapsed since the profile was reset along with the count, total and maximum duration of every stage
+         */
+        static std::string Report();
+    };
+
+    /**
+     * @brief The ScopedTimer class records the duration of its own lifetime as an occurrence of a stage
+     */
+    class ScopedTimer {
+      private:
+        Stage stage;
+        u64 start;
+
+      public:
+        ScopedTimer(Stage stage) : stage(stage), start(util::GetTimeNs()) {}
+
+        ScopedTimer(const ScopedTimer &) = delete;
+
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        ~ScopedTimer() {
+            BootProfile::Record(stage, util::GetTimeNs() - start);
+        }
+    };
+}
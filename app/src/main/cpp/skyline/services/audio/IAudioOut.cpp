@@ -16,7 +16,7 @@ namespace skyline::service::audio {
         {0x7, SFUNC(IAudioOut::AppendAudioOutBuffer)},
         {0x8, SFUNC(IAudioOut::GetReleasedAudioOutBuffer)}
     }) {
-        track = state.audio->OpenTrack(channelCount, constant::SampleRate, [this]() { this->releaseEvent->Signal(); });
+        track = state.audio->OpenTrack(channelCount, sampleRate, [this]() { this->releaseEvent->Signal(); });
     }
 
     IAudioOut::~IAudioOut() {
@@ -52,12 +52,7 @@ namespace skyline::service::audio {
 
         state.logger->Debug("IAudioOut: Appending buffer with address: 0x{:X}, size: 0x{:X}", data.sampleBufferPtr, data.sampleSize);
 
-        if (sampleRate != constant::SampleRate) {
-            auto resampledBuffer = resampler.ResampleBuffer(std::span(state.process->GetPointer<i16>(data.sampleBufferPtr), data.sampleSize / sizeof(i16)), static_cast<double>(sampleRate) / constant::SampleRate, channelCount);
-            track->AppendBuffer(tag, resampledBuffer);
-        } else {
-            track->AppendBuffer(tag, std::span(state.process->GetPointer<i16>(data.sampleBufferPtr), data.sampleSize / sizeof(i16)));
-        }
+        track->AppendBuffer(tag, std::span(state.process->GetPointer<i16>(data.sampleBufferPtr), data.sampleSize / sizeof(i16)));
 
         return {};
     }
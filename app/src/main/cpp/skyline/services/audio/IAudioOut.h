@@ -6,7 +6,6 @@
 #include <kernel/types/KEvent.h>
 #include <services/base_service.h>
 #include <services/serviceman.h>
-#include <audio/resampler.h>
 #include <audio.h>
 
 namespace skyline::service::audio {
@@ -15,7 +14,6 @@ namespace skyline::service::audio {
      */
     class IAudioOut : public BaseService {
       private:
-        skyline::audio::Resampler resampler; //!< The audio resampler object used to resample audio
         std::shared_ptr<skyline::audio::AudioTrack> track; //!< The audio track associated with the audio out
         std::shared_ptr<type::KEvent> releaseEvent; //!< The KEvent that is signalled when a buffer has been released
 
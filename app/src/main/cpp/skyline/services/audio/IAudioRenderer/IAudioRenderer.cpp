@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <numeric>
 #include <kernel/types/KProcess.h>
 #include "IAudioRenderer.h"
 
@@ -17,20 +18,43 @@ namespace skyline::service::audio::IAudioRenderer {
         {0x7, SFUNC(IAudioRenderer::QuerySystemEvent)},
         {0xA, SFUNC(IAudioRenderer::RequestUpdate)},
     }) {
-        track = state.audio->OpenTrack(constant::ChannelCount, constant::SampleRate, []() {});
+        if (!parameters.sampleRate || !parameters.sampleCount)
+            throw exception("Invalid audio renderer parameters: sample rate: {}, sample count: {}", parameters.sampleRate, parameters.sampleCount);
+
+        track = state.audio->OpenTrack(constant::ChannelCount, constant::SampleRate, [this]() {
+            std::lock_guard lock(releaseLock);
+            releasePending = true;
+            releaseCondition.notify_one();
+        });
         track->Start();
 
         memoryPools.resize(parameters.effectCount + parameters.voiceCount * 4);
-        effects.resize(parameters.effectCount);
+        effects.resize(parameters.effectCount, Effect(state));
         voices.resize(parameters.voiceCount, Voice(state));
 
+        memoryPoolsIn.resize(memoryPools.size());
+        voicesIn.resize(parameters.voiceCount);
+        effectsIn.resize(parameters.effectCount);
+
+        effectOrder.resize(parameters.effectCount);
+        std::iota(effectOrder.begin(), effectOrder.end(), 0);
+
         // Fill track with empty samples that we will triple buffer
         track->AppendBuffer(0);
         track->AppendBuffer(1);
         track->AppendBuffer(2);
+
+        rendererThread = std::thread(&IAudioRenderer::RendererThread, this);
     }
 
     IAudioRenderer::~IAudioRenderer() {
+        {
+            std::lock_guard lock(releaseLock);
+            rendererRunning = false;
+        }
+        releaseCondition.notify_one();
+        rendererThread.join();
+
         state.audio->CloseTrack(track);
     }
 
@@ -55,37 +79,27 @@ namespace skyline::service::audio::IAudioRenderer {
     }
 
     Result IAudioRenderer::RequestUpdate(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        auto inputAddress{request.inputBuf.at(0).address};
+        auto &inputBuffer{request.inputBuf.at(0)};
+        auto inputAddress{inputBuffer.address};
 
         auto inputHeader{state.process->GetObject<UpdateDataHeader>(inputAddress)};
+        if (inputHeader.totalSize > inputBuffer.size)
+            throw exception("Audio renderer update is larger than the input buffer: 0x{:X} > 0x{:X}", inputHeader.totalSize, inputBuffer.size);
+        if (inputHeader.memoryPoolSize < memoryPoolsIn.size() * sizeof(MemoryPoolIn) || inputHeader.voiceSize < voicesIn.size() * sizeof(VoiceIn) || inputHeader.effectSize < effectsIn.size() * sizeof(EffectIn))
+            throw exception("Audio renderer update is missing data: memory pools: 0x{:X}, voices: 0x{:X}, effects: 0x{:X}", inputHeader.memoryPoolSize, inputHeader.voiceSize, inputHeader.effectSize);
+
         revisionInfo.SetUserRevision(inputHeader.revision);
         inputAddress += sizeof(UpdateDataHeader);
         inputAddress += inputHeader.behaviorSize; // Unused
 
-        auto memoryPoolCount{memoryPools.size()};
-        std::vector<MemoryPoolIn> memoryPoolsIn(memoryPoolCount);
-        state.process->ReadMemory(memoryPoolsIn.data(), inputAddress, memoryPoolCount * sizeof(MemoryPoolIn));
+        state.process->ReadMemory(memoryPoolsIn.data(), inputAddress, memoryPoolsIn.size() * sizeof(MemoryPoolIn));
         inputAddress += inputHeader.memoryPoolSize;
 
-        for (auto i = 0; i < memoryPoolsIn.size(); i++)
-            memoryPools[i].ProcessInput(memoryPoolsIn[i]);
-
         inputAddress += inputHeader.voiceResourceSize;
-        std::vector<VoiceIn> voicesIn(parameters.voiceCount);
-        state.process->ReadMemory(voicesIn.data(), inputAddress, parameters.voiceCount * sizeof(VoiceIn));
+        state.process->ReadMemory(voicesIn.data(), inputAddress, voicesIn.size() * sizeof(VoiceIn));
         inputAddress += inputHeader.voiceSize;
 
-        for (auto i = 0; i < voicesIn.size(); i++)
-            voices[i].ProcessInput(voicesIn[i]);
-
-        std::vector<EffectIn> effectsIn(parameters.effectCount);
-        state.process->ReadMemory(effectsIn.data(), inputAddress, parameters.effectCount * sizeof(EffectIn));
-
-        for (auto i = 0; i < effectsIn.size(); i++)
-            effects[i].ProcessInput(effectsIn[i]);
-
-        UpdateAudio();
-        systemEvent->Signal();
+        state.process->ReadMemory(effectsIn.data(), inputAddress, effectsIn.size() * sizeof(EffectIn));
 
         UpdateDataHeader outputHeader{
             .revision = constant::RevMagic,
@@ -115,6 +129,22 @@ namespace skyline::service::audio::IAudioRenderer {
         state.process->WriteMemory(outputHeader, outputAddress);
         outputAddress += sizeof(UpdateDataHeader);
 
+        // The renderer thread only needs to be blocked while the new state is applied and the resulting state is written back
+        std::lock_guard guard(rendererLock);
+
+        for (auto i = 0; i < memoryPoolsIn.size(); i++)
+            memoryPools[i].ProcessInput(memoryPoolsIn[i]);
+
+        for (auto i = 0; i < voicesIn.size(); i++)
+            voices[i].ProcessInput(voicesIn[i]);
+
+        for (auto i = 0; i < effectsIn.size(); i++)
+            effects[i].ProcessInput(effectsIn[i]);
+
+        std::stable_sort(effectOrder.begin(), effectOrder.end(), [this](u32 a, u32 b) {
+            return effects[a].processingOrder < effects[b].processingOrder;
+        });
+
         for (const auto &memoryPool : memoryPools) {
             state.process->WriteMemory(memoryPool.output, outputAddress);
             outputAddress += sizeof(MemoryPoolOut);
@@ -133,6 +163,38 @@ namespace skyline::service::audio::IAudioRenderer {
         return {};
     }
 
+    void IAudioRenderer::RendererThread() {
+        auto framePeriod{std::chrono::nanoseconds(static_cast<u64>(parameters.sampleCount) * constant::NsInSecond / parameters.sampleRate)}; //!< The duration of a single audio frame, this is the rate at which the DSP signals the system event
+        auto nextFrame{std::chrono::steady_clock::now() + framePeriod};
+
+        try {
+            while (true) {
+                {
+                    std::unique_lock lock(releaseLock);
+                    releaseCondition.wait_until(lock, nextFrame, [this] { return releasePending || !rendererRunning; });
+
+                    if (!rendererRunning)
+                        break;
+
+                    releasePending = false;
+                }
+
+                {
+                    std::lock_guard guard(rendererLock);
+                    UpdateAudio();
+                }
+
+                auto now{std::chrono::steady_clock::now()};
+                if (now >= nextFrame) {
+                    systemEvent->Signal();
+                    nextFrame = std::max(nextFrame + framePeriod, now); // We don't want to signal a burst of frames after the thread has been stalled
+                }
+            }
+        } catch (const std::exception &e) {
+            state.logger->Error("IAudioRenderer: Renderer thread has encountered an exception: {}", e.what());
+        }
+    }
+
     void IAudioRenderer::UpdateAudio() {
         auto released{track->GetReleasedBuffers(2)};
 
@@ -143,7 +205,8 @@ namespace skyline::service::audio::IAudioRenderer {
     }
 
     void IAudioRenderer::MixFinalBuffer() {
-        u32 writtenSamples = 0;
+        for (auto &mixBuffer : mixBuffers)
+            std::fill(mixBuffer.begin(), mixBuffer.end(), 0.0f);
 
         for (auto &voice : voices) {
             if (!voice.Playable())
@@ -163,18 +226,36 @@ namespace skyline::service::audio::IAudioRenderer {
                 pendingSamples -= voiceBufferSize / constant::ChannelCount;
 
                 for (auto index{voiceBufferOffset}; index < voiceBufferOffset + voiceBufferSize; index++) {
-                    if (writtenSamples == bufferOffset) {
-                        sampleBuffer[bufferOffset] = skyline::audio::Saturate<i16, i32>(voiceSamples[index] * voice.volume);
-
-                        writtenSamples++;
-                    } else {
-                        sampleBuffer[bufferOffset] = skyline::audio::Saturate<i16, i32>(sampleBuffer[bufferOffset] + (voiceSamples[index] * voice.volume));
-                    }
-
+                    mixBuffers[bufferOffset % constant::ChannelCount][bufferOffset / constant::ChannelCount] += voiceSamples[index] * voice.volume;
                     bufferOffset++;
                 }
             }
         }
+
+        ProcessEffects();
+
+        for (u32 frame{}; frame < constant::MixBufferSize; frame++)
+            for (u8 channel{}; channel < constant::ChannelCount; channel++)
+                sampleBuffer[frame * constant::ChannelCount + channel] = skyline::audio::Saturate<i16, float>(mixBuffers[channel][frame]);
+    }
+
+    void IAudioRenderer::ProcessEffects() {
+        auto budget{constant::EffectFrameBudget * constant::MixBufferSize / parameters.sampleCount};
+        auto startTime{util::GetTimeNs()};
+
+        for (auto index : effectOrder) {
+            auto &effect{effects[index]};
+            if (!effect.Active())
+                continue;
+
+            if (util::GetTimeNs() - startTime > budget) {
+                if (!droppedEffectCount++)
+                    state.logger->Warn("IAudioRenderer: Effect processing has exceeded its budget of {} ns, effects past it are being bypassed", budget);
+                continue;
+            }
+
+            effect.Process(mixBuffers);
+        }
     }
 
     Result IAudioRenderer::Start(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <kernel/types/KEvent.h>
 #include <services/base_service.h>
 #include <services/serviceman.h>
@@ -15,6 +16,7 @@
 namespace skyline {
     namespace constant {
         constexpr auto BufferAlignment = 0x40; //!< The alignment for all audren buffers
+        constexpr u64 EffectFrameBudget{500000}; //!< The amount of CPU time in nanoseconds that effects are allowed to consume per audio frame, effects past this are bypassed
     }
 
     namespace service::audio::IAudioRenderer {
@@ -70,15 +72,38 @@ namespace skyline {
             std::vector<MemoryPool> memoryPools;
             std::vector<Effect> effects;
             std::vector<Voice> voices;
+            std::vector<MemoryPoolIn> memoryPoolsIn; //!< The memory pool input from the last update, this is preallocated to avoid allocations in RequestUpdate
+            std::vector<VoiceIn> voicesIn; //!< The voice input from the last update, this is preallocated to avoid allocations in RequestUpdate
+            std::vector<EffectIn> effectsIn; //!< The effect input from the last update, this is preallocated to avoid allocations in RequestUpdate
+            std::vector<u32> effectOrder; //!< The indices of all effects sorted by their processing order
+            u64 droppedEffectCount{}; //!< The amount of times an effect has been bypassed due to exceeding the effect budget
+            std::array<std::array<float, constant::MixBufferSize>, constant::ChannelCount> mixBuffers{}; //!< The planar mix of all voices which effects are applied to
             std::array<i16, constant::MixBufferSize * constant::ChannelCount> sampleBuffer{}; //!< The final output data that is appended to the stream
             skyline::audio::AudioOutState playbackState{skyline::audio::AudioOutState::Stopped};
 
+            std::thread rendererThread; //!< The thread which mixes voices at the audio clock rate, this emulates the DSP and decouples mixing from guest IPC
+            std::mutex rendererLock; //!< This mutex is used to synchronize access to the voices, memory pools and effects between the IPC and renderer threads
+            std::mutex releaseLock; //!< This mutex is used alongside releaseCondition to wait for buffers to be released by the track
+            std::condition_variable releaseCondition; //!< This is signalled by the track when it releases a buffer
+            bool releasePending{}; //!< If the track has released a buffer that hasn't been refilled by the renderer thread yet
+            bool rendererRunning{true}; //!< If the renderer thread should keep running, this is guarded by releaseLock
+
+            /**
+             * @brief The entry point of the renderer thread, this mixes and appends buffers whenever the track releases them and signals the system event every audio frame
+             */
+            void RendererThread();
+
             /**
              * @brief Obtains new sample data from voices and mixes it together into the sample buffer
              * @return The amount of samples present in the buffer
              */
             void MixFinalBuffer();
 
+            /**
+             * @brief Applies all enabled effects to the mix buffers in their processing order within the effect budget
+             */
+            void ProcessEffects();
+
             /**
              * @brief Appends all released buffers with new mixed sample data
              */
@@ -91,7 +116,7 @@ namespace skyline {
             IAudioRenderer(const DeviceState &state, ServiceManager &manager, AudioRendererParameters &parameters);
 
             /**
-             * @brief Closes the audio track
+             * @brief Stops the renderer thread and closes the audio track
              */
             ~IAudioRenderer();
 
@@ -116,7 +141,7 @@ namespace skyline {
             Result GetState(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
             /**
-            * @brief Updates the audio renderer state and appends new data to playback buffers
+            * @brief Validates and applies an update of the audio renderer state from the guest, mixing is performed asynchronously by the renderer thread
             */
             Result RequestUpdate(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response);
 
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include <cmath>
+#include <kernel/types/KProcess.h>
+#include "effect.h"
+
+namespace skyline::service::audio::IAudioRenderer {
+    /**
+     * @param value A Q14 fixed point value
+     * @return The corresponding floating point value
+     */
+    constexpr float FixedToFloat(i32 value) {
+        return static_cast<float>(value) / (1 << 14);
+    }
+
+    /**
+     * @param value A gain in millibels
+     * @return The corresponding linear gain
+     */
+    inline float MillibelToLinear(float value) {
+        return std::pow(10.0f, value / 2000.0f);
+    }
+
+    Effect::Effect(const DeviceState &state) : state(state) {}
+
+    void Effect::MapChannels(std::span<const i8> inputBuffers, std::span<const i8> outputBuffers, u32 count) {
+        channelCount = 0;
+
+        for (u32 channel{}; channel < std::min(static_cast<size_t>(count), inputBuffers.size()) && channelCount < constant::EffectMaxChannels; channel++) {
+            auto input{inputBuffers[channel]};
+            auto output{outputBuffers[channel]};
+            if (input < 0 || output < 0 || input >= constant::ChannelCount || output >= constant::ChannelCount)
+                continue;
+
+            inputs[channelCount] = static_cast<u8>(input);
+            outputs[channelCount] = static_cast<u8>(output);
+            sources[channelCount] = static_cast<u8>(channel);
+            channelCount++;
+        }
+    }
+
+    void Effect::ProcessInput(const EffectIn &input) {
+        if (input.isNew && input.type != type) {
+            delay.Reset();
+            reverb.Reset();
+        }
+
+        type = input.type;
+        enabled = input.enabled;
+        processingOrder = input.processingOrder;
+
+        if (type == EffectType::Invalid)
+            output.state = EffectState::None;
+        else if (input.isNew)
+            output.state = EffectState::New;
+        else
+            output.state = enabled ? EffectState::Enabled : EffectState::Disabled;
+
+        switch (type) {
+            case EffectType::Delay: {
+                const auto &parameters{*reinterpret_cast<const DelayParameters *>(input.parameters.data())};
+                MapChannels(parameters.inputs, parameters.outputs, parameters.channelCount);
+
+                delay.Configure(skyline::audio::DelayEffect::Parameters{
+                    .delayTimeMax = parameters.delayTimeMax,
+                    .delayTime = parameters.delayTime,
+                    .inGain = FixedToFloat(parameters.inGain),
+                    .feedbackGain = FixedToFloat(parameters.feedbackGain),
+                    .wetGain = FixedToFloat(parameters.wetGain),
+                    .dryGain = FixedToFloat(parameters.dryGain),
+                    .channelSpread = FixedToFloat(parameters.channelSpread),
+                    .lowpassAmount = FixedToFloat(parameters.lowpassAmount),
+                }, constant::SampleRate);
+                break;
+            }
+
+            case EffectType::Reverb: {
+                const auto &parameters{*reinterpret_cast<const ReverbParameters *>(input.parameters.data())};
+                MapChannels(parameters.inputs, parameters.outputs, parameters.channelCount);
+
+                constexpr std::array<float, 5> EarlyModeScales{0.5f, 1.0f, 1.5f, 2.0f, 0.0f}; //!< The early reflection time scale for: Small Room, Large Room, Hall, Cathedral and No Early Reflections
+                constexpr std::array<float, 5> LateModeScales{0.5f, 1.0f, 0.75f, 1.5f, 2.0f}; //!< The late reverberation line scale for: Room, Hall, Metallic Room, Cathedral and Maximum Delay
+
+                auto earlyMode{std::min(parameters.earlyMode, static_cast<u32>(EarlyModeScales.size() - 1))};
+                auto earlyScale{EarlyModeScales[earlyMode]};
+                auto preDelay{FixedToFloat(parameters.preDelay) / 1000.0f};
+
+                reverb.Configure(skyline::audio::ReverbEffect::Parameters{
+                    .preDelay = preDelay,
+                    .lateDelay = preDelay + 0.03f * earlyScale,
+                    .earlyScale = earlyScale,
+                    .lateScale = LateModeScales[std::min(parameters.lateMode, static_cast<u32>(LateModeScales.size() - 1))],
+                    .decayTime = FixedToFloat(parameters.decayTime),
+                    .damping = 1.0f - FixedToFloat(parameters.highFrequencyDecayRatio),
+                    .inGain = FixedToFloat(parameters.baseGain),
+                    .earlyGain = earlyScale != 0.0f ? FixedToFloat(parameters.earlyGain) : 0.0f,
+                    .lateGain = FixedToFloat(parameters.lateGain),
+                    .wetGain = FixedToFloat(parameters.wetGain),
+                    .dryGain = FixedToFloat(parameters.dryGain),
+                }, constant::SampleRate);
+                break;
+            }
+
+            case EffectType::I3dl2Reverb: {
+                const auto &parameters{*reinterpret_cast<const I3dl2ReverbParameters *>(input.parameters.data())};
+                MapChannels(parameters.inputs, parameters.outputs, parameters.channelCount);
+
+                reverb.Configure(skyline::audio::ReverbEffect::Parameters{
+                    .preDelay = parameters.reflectionDelay,
+                    .lateDelay = parameters.reflectionDelay + parameters.lateReverbDelayTime,
+                    .earlyScale = 1.0f,
+                    .lateScale = 0.5f + 1.5f * std::clamp(parameters.lateReverbDensity / 100.0f, 0.0f, 1.0f),
+                    .decayTime = parameters.lateReverbDecayTime,
+                    .damping = 1.0f - std::clamp(parameters.lateReverbHfDecayRatio * MillibelToLinear(parameters.roomHfGain), 0.0f, 1.0f),
+                    .inGain = 1.0f,
+                    .earlyGain = MillibelToLinear(parameters.roomGain + parameters.reflectionGain),
+                    .lateGain = MillibelToLinear(parameters.roomGain + parameters.reverbGain),
+                    .wetGain = 1.0f,
+                    .dryGain = parameters.dryGain,
+                }, constant::SampleRate);
+                break;
+            }
+
+            case EffectType::Aux:
+                aux = *reinterpret_cast<const AuxParameters *>(input.parameters.data());
+                MapChannels(aux.inputs, aux.outputs, aux.mixBufferCount);
+                break;
+
+            default:
+                if (input.isNew && type != EffectType::Invalid)
+                    state.logger->Warn("Unsupported audio renderer effect type: {}", type);
+                channelCount = 0;
+                break;
+        }
+    }
+
+    void Effect::Process(std::span<std::array<float, constant::MixBufferSize>> mixBuffers) {
+        if (type == EffectType::Aux) {
+            ProcessAux(mixBuffers);
+            return;
+        }
+
+        std::array<std::span<float>, constant::EffectMaxChannels> inputSpans;
+        std::array<std::span<float>, constant::EffectMaxChannels> outputSpans;
+        for (u8 channel{}; channel < channelCount; channel++) {
+            inputSpans[channel] = mixBuffers[inputs[channel]];
+            outputSpans[channel] = mixBuffers[outputs[channel]];
+        }
+
+        std::span<const std::span<float>> inputChannels(inputSpans.data(), channelCount);
+        std::span<const std::span<float>> outputChannels(outputSpans.data(), channelCount);
+
+        if (type == EffectType::Delay)
+            delay.Process(inputChannels, outputChannels);
+        else if (type == EffectType::Reverb || type == EffectType::I3dl2Reverb)
+            reverb.Process(inputChannels, outputChannels);
+    }
+
+    void Effect::ProcessAux(std::span<std::array<float, constant::MixBufferSize>> mixBuffers) {
+        if (!aux.sampleCountMax || !aux.sendBufferInfoAddress || !aux.returnBufferInfoAddress)
+            return;
+
+        auto sendInfo{state.process->GetObject<AuxBufferInfo>(aux.sendBufferInfoAddress)};
+        auto returnInfo{state.process->GetObject<AuxBufferInfo>(aux.returnBufferInfoAddress)};
+
+        auto sampleCount{std::min(static_cast<u32>(constant::MixBufferSize), aux.sampleCountMax)};
+        auto returnAvailable{std::min((returnInfo.writeOffset + aux.sampleCountMax - returnInfo.readOffset) % aux.sampleCountMax, sampleCount)};
+
+        // Transfers a region of a guest circular buffer which may wrap around to or from the auxiliary buffer
+        auto transfer{[this](u64 address, u32 offset, u32 count, bool write) {
+            auto firstCount{std::min(count, aux.sampleCountMax - offset)};
+            auto transferMemory{[this, write](i32 *buffer, u64 address, u32 count) {
+                if (write)
+                    state.process->WriteMemory(buffer, address, count * sizeof(i32));
+                else
+                    state.process->ReadMemory(buffer, address, count * sizeof(i32));
+            }};
+
+            transferMemory(auxBuffer.data(), address + offset * sizeof(i32), firstCount);
+            if (count > firstCount)
+                transferMemory(auxBuffer.data() + firstCount, address, count - firstCount);
+        }};
+
+        for (u8 channel{}; channel < channelCount; channel++) {
+            auto channelOffset{static_cast<u64>(sources[channel]) * aux.sampleCountMax * sizeof(i32)};
+
+            auto &inputBuffer{mixBuffers[inputs[channel]]};
+            for (u32 index{}; index < sampleCount; index++)
+                auxBuffer[index] = static_cast<i32>(inputBuffer[index]);
+            transfer(aux.sendBufferAddress + channelOffset, sendInfo.writeOffset % aux.sampleCountMax, sampleCount, true);
+
+            auto &outputBuffer{mixBuffers[outputs[channel]]};
+            transfer(aux.returnBufferAddress + channelOffset, returnInfo.readOffset % aux.sampleCountMax, returnAvailable, false);
+            for (u32 index{}; index < returnAvailable; index++)
+                outputBuffer[index] = static_cast<float>(auxBuffer[index]);
+            std::fill(outputBuffer.begin() + returnAvailable, outputBuffer.end(), 0.0f);
+        }
+
+        // Only the offsets we own are written back as the guest might be concurrently modifying the others
+        u32 sendWriteOffset{(sendInfo.writeOffset + sampleCount) % aux.sampleCountMax};
+        u32 sendTotalSampleCount{sendInfo.totalSampleCount + sampleCount};
+        u32 returnReadOffset{(returnInfo.readOffset + returnAvailable) % aux.sampleCountMax};
+        state.process->WriteMemory(sendWriteOffset, aux.sendBufferInfoAddress + offsetof(AuxBufferInfo, writeOffset));
+        state.process->WriteMemory(sendTotalSampleCount, aux.sendBufferInfoAddress + offsetof(AuxBufferInfo, totalSampleCount));
+        state.process->WriteMemory(returnReadOffset, aux.returnBufferInfoAddress + offsetof(AuxBufferInfo, readOffset));
+    }
+}
@@ -3,46 +3,229 @@
 
 #pragma once
 
+#include <audio/effects.h>
 #include <common.h>
 
-namespace skyline::service::audio::IAudioRenderer {
-    /**
-     * @brief This enumerates various states an effect can be in
-     */
-    enum class EffectState : u8 {
-        None = 0, //!< The effect isn't being used
-        New = 1,
-    };
-
-    /**
-     * @brief This is in input containing information on what effects to use on an audio stream
-     */
-    struct EffectIn {
-        u8 _unk0_;
-        u8 isNew; //!< Whether the effect was used in the previous samples
-        u8 _unk1_[0xBE];
-    };
-    static_assert(sizeof(EffectIn) == 0xC0);
-
-    /**
-     * @brief This is returned to inform the guest of the state of an effect
-     */
-    struct EffectOut {
-        EffectState state;
-        u8 _pad0_[15];
-    };
-    static_assert(sizeof(EffectOut) == 0x10);
-
-    /**
-    * @brief The Effect class stores the state of audio post processing effects
-    */
-    class Effect {
-      public:
-        EffectOut output{};
-
-        inline void ProcessInput(const EffectIn &input) {
-            if (input.isNew)
-                output.state = EffectState::New;
-        }
-    };
+namespace skyline {
+    namespace constant {
+        constexpr u8 EffectChannelCount{6}; //!< The maximum amount of channels delay and reverb effects can have
+        constexpr u8 AuxMixBufferCount{24}; //!< The maximum amount of mix buffers an auxiliary bus can send and return
+    }
+
+    namespace service::audio::IAudioRenderer {
+        /**
+         * @brief This enumerates various states an effect can be in
+         */
+        enum class EffectState : u8 {
+            None = 0, //!< The effect isn't being used
+            New = 1, //!< The effect was just added
+            Enabled = 2, //!< The effect is being processed
+            Disabled = 3, //!< The effect is present but not being processed
+        };
+
+        /**
+         * @brief This enumerates the types of effects
+         */
+        enum class EffectType : u8 {
+            Invalid = 0,
+            BufferMixer = 1,
+            Aux = 2, //!< An auxiliary bus which sends samples to the guest and returns samples from it
+            Delay = 3,
+            Reverb = 4,
+            I3dl2Reverb = 5,
+            BiquadFilter = 6,
+        };
+
+        /**
+         * @brief This is in input containing information on what effects to use on an audio stream
+         */
+        struct EffectIn {
+            EffectType type;
+            u8 isNew; //!< Whether the effect was used in the previous samples
+            u8 enabled;
+            u8 _pad0_;
+            u32 mixId;
+            u64 bufferAddress; //!< The address of the work buffer allocated by the guest for this effect
+            u64 bufferSize;
+            u32 processingOrder; //!< The order in which this effect is processed relative to other effects
+            u32 _pad1_;
+            std::array<u8, 0xA0> parameters; //!< The parameters specific to the type of the effect
+        };
+        static_assert(sizeof(EffectIn) == 0xC0);
+
+        /**
+         * @brief This is returned to inform the guest of the state of an effect
+         */
+        struct EffectOut {
+            EffectState state;
+            u8 _pad0_[15];
+        };
+        static_assert(sizeof(EffectOut) == 0x10);
+
+        /**
+         * @brief The parameters of a delay effect, all gains are Q14 fixed point
+         */
+        struct DelayParameters {
+            std::array<i8, constant::EffectChannelCount> inputs; //!< The mix buffers used as input for every channel
+            std::array<i8, constant::EffectChannelCount> outputs; //!< The mix buffers used as output for every channel
+            u16 channelCountMax;
+            u16 channelCount;
+            u32 delayTimeMax; //!< The maximum delay time in milliseconds
+            u32 delayTime; //!< The delay time in milliseconds
+            i32 sampleRate;
+            i32 inGain;
+            i32 feedbackGain;
+            i32 wetGain;
+            i32 dryGain;
+            i32 channelSpread;
+            i32 lowpassAmount;
+            u8 parameterState;
+            u8 _pad0_[3];
+        };
+        static_assert(sizeof(DelayParameters) == 0x38);
+
+        /**
+         * @brief The parameters of a reverb effect, all gains and times are Q14 fixed point
+         */
+        struct ReverbParameters {
+            std::array<i8, constant::EffectChannelCount> inputs; //!< The mix buffers used as input for every channel
+            std::array<i8, constant::EffectChannelCount> outputs; //!< The mix buffers used as output for every channel
+            u16 channelCountMax;
+            u16 channelCount;
+            u32 _unk0_;
+            u32 sampleRate;
+            u32 earlyMode; //!< The preset used for early reflections
+            i32 earlyGain;
+            i32 preDelay; //!< The delay prior to early reflections in milliseconds
+            u32 lateMode; //!< The preset used for late reverberation
+            i32 lateGain;
+            i32 decayTime; //!< The decay time of the late reverberation in seconds
+            i32 highFrequencyDecayRatio;
+            i32 colouration;
+            i32 baseGain;
+            i32 wetGain;
+            i32 dryGain;
+            u8 parameterState;
+            u8 reset;
+            u8 _pad0_[2];
+        };
+        static_assert(sizeof(ReverbParameters) == 0x48);
+
+        /**
+         * @brief The parameters of an I3DL2 reverb effect, gains are in millibels unless specified otherwise
+         * @url https://www.iasig.org/pubs/3dl2v1a.pdf
+         */
+        struct I3dl2ReverbParameters {
+            std::array<i8, constant::EffectChannelCount> inputs; //!< The mix buffers used as input for every channel
+            std::array<i8, constant::EffectChannelCount> outputs; //!< The mix buffers used as output for every channel
+            u16 channelCountMax;
+            u16 channelCount;
+            u32 _unk0_;
+            u32 sampleRate;
+            float roomHfGain;
+            float referenceHf;
+            float lateReverbDecayTime; //!< The decay time of the late reverberation in seconds
+            float lateReverbHfDecayRatio;
+            float roomGain;
+            float reflectionGain;
+            float reverbGain;
+            float lateReverbDiffusion; //!< The echo density of the late reverberation in percent
+            float reflectionDelay; //!< The delay prior to early reflections in seconds
+            float lateReverbDelayTime; //!< The delay of the late reverberation relative to the early reflections in seconds
+            float lateReverbDensity; //!< The modal density of the late reverberation in percent
+            float dryGain; //!< The linear gain of the dry signal
+            u8 parameterState;
+            u8 reset;
+            u8 _pad0_[2];
+        };
+        static_assert(sizeof(I3dl2ReverbParameters) == 0x4C);
+
+        /**
+         * @brief The parameters of an auxiliary bus
+         */
+        struct AuxParameters {
+            std::array<i8, constant::AuxMixBufferCount> inputs; //!< The mix buffers that are sent to the guest
+            std::array<i8, constant::AuxMixBufferCount> outputs; //!< The mix buffers that are returned from the guest
+            u32 mixBufferCount;
+            u32 sampleRate;
+            u32 sampleCountMax; //!< The size of the send and return buffers of a single channel in samples
+            u32 mixBufferCountMax;
+            u64 sendBufferInfoAddress;
+            u64 sendBufferAddress;
+            u64 returnBufferInfoAddress;
+            u64 returnBufferAddress;
+            u32 mixBufferSampleSize;
+            u32 sampleCount;
+            u32 mixBufferSampleCount;
+            u32 _pad0_;
+        };
+        static_assert(sizeof(AuxParameters) == 0x70);
+
+        /**
+         * @brief The state of an auxiliary circular buffer which is shared with the guest
+         */
+        struct AuxBufferInfo {
+            u32 readOffset; //!< The offset the consumer will read the next sample from
+            u32 writeOffset; //!< The offset the producer will write the next sample to
+            u32 lostSampleCount;
+            u32 totalSampleCount;
+            u32 _pad0_[12];
+        };
+        static_assert(sizeof(AuxBufferInfo) == 0x40);
+
+        /**
+        * @brief The Effect class stores the state of audio post processing effects and applies them to the final mix
+        * @note We don't emulate submixes, so effects are applied to the channels of the final mix their input and output mix buffers correspond to
+        */
+        class Effect {
+          private:
+            const DeviceState &state;
+            EffectType type{EffectType::Invalid};
+            bool enabled{};
+            u8 channelCount{}; //!< The amount of channels that map to the final mix
+            std::array<u8, constant::EffectMaxChannels> inputs{}; //!< The final mix channel used as input for every effect channel
+            std::array<u8, constant::EffectMaxChannels> outputs{}; //!< The final mix channel used as output for every effect channel
+            std::array<u8, constant::EffectMaxChannels> sources{}; //!< The index of every mapped channel in the guest's channel layout
+            skyline::audio::DelayEffect delay;
+            skyline::audio::ReverbEffect reverb;
+            AuxParameters aux{};
+            std::array<i32, constant::MixBufferSize> auxBuffer{}; //!< A preallocated buffer used to convert samples to and from the guest auxiliary buffer format
+
+            /**
+             * @brief Maps the effect channels to channels in the final mix, any channel that doesn't map to the final mix is dropped
+             */
+            void MapChannels(std::span<const i8> inputBuffers, std::span<const i8> outputBuffers, u32 count);
+
+            /**
+             * @brief Sends the input channels to the guest auxiliary buffer and replaces the output channels with the returned samples
+             */
+            void ProcessAux(std::span<std::array<float, constant::MixBufferSize>> mixBuffers);
+
+          public:
+            EffectOut output{};
+            u32 processingOrder{};
+
+            Effect(const DeviceState &state);
+
+            /**
+             * @brief Processes the input effect data from the guest and configures the effect based off it
+             * @param input The input data struct from guest
+             * @note This is where any allocations for the effect happen, processing is allocation-free
+             */
+            void ProcessInput(const EffectIn &input);
+
+            /**
+             * @brief Applies the effect to the final mix
+             * @param mixBuffers The planar samples of every channel in the final mix
+             */
+            void Process(std::span<std::array<float, constant::MixBufferSize>> mixBuffers);
+
+            /**
+             * @return If the effect needs to be processed
+             */
+            inline bool Active() {
+                return enabled && channelCount && type != EffectType::Invalid;
+            }
+        };
+    }
 }
@@ -2,6 +2,7 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <kernel/types/KProcess.h>
+#include <vfs/readahead_backing.h>
 #include "results.h"
 #include "IFile.h"
 
@@ -12,7 +13,13 @@ namespace skyline::service::fssrv {
         {0x2, SFUNC(IFile::Flush)},
         {0x3, SFUNC(IFile::SetSize)},
         {0x4, SFUNC(IFile::GetSize)}
-    }) {}
+    }) {
+        // Files that can be written to aren't prefetched as the prefetched data could become stale
+        if (backing->mode.write || backing->mode.append)
+            readBacking = backing;
+        else
+            readBacking = std::make_shared<vfs::ReadaheadBacking>(backing);
+    }
 
     Result IFile::Read(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
         auto readOption = request.Pop<u32>();
@@ -30,7 +37,7 @@ namespace skyline::service::fssrv {
             return result::InvalidSize;
         }
 
-        response.Push<u32>(static_cast<u32>(backing->Read(state.process->GetPointer<u8>(request.outputBuf.at(0).address), offset, size)));
+        response.Push<u32>(static_cast<u32>(readBacking->Read(state.process->GetPointer<u8>(request.outputBuf.at(0).address), offset, size)));
         return {};
     }
 
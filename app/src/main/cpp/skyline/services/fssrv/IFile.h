@@ -14,6 +14,7 @@ namespace skyline::service::fssrv {
     class IFile : public BaseService {
       private:
         std::shared_ptr<vfs::Backing> backing; //!< The backing of the IFile
+        std::shared_ptr<vfs::Backing> readBacking; //!< The backing used for reads, this prefetches data asynchronously if the file is read-only
 
       public:
         IFile(std::shared_ptr<vfs::Backing> &backing, const DeviceState &state, ServiceManager &manager);
@@ -2,11 +2,12 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <kernel/types/KProcess.h>
+#include <vfs/readahead_backing.h>
 #include "results.h"
 #include "IStorage.h"
 
 namespace skyline::service::fssrv {
-    IStorage::IStorage(std::shared_ptr<vfs::Backing> &backing, const DeviceState &state, ServiceManager &manager) : backing(backing), BaseService(state, manager, {
+    IStorage::IStorage(std::shared_ptr<vfs::Backing> &backing, const DeviceState &state, ServiceManager &manager) : backing(backing ? std::make_shared<vfs::ReadaheadBacking>(backing) : backing), BaseService(state, manager, {
         {0x0, SFUNC(IStorage::Read)},
         {0x4, SFUNC(IStorage::GetSize)}
     }) {}
@@ -13,7 +13,7 @@ namespace skyline::service::fssrv {
      */
     class IStorage : public BaseService {
       private:
-        std::shared_ptr<vfs::Backing> backing; //!< The backing of the IStorage
+        std::shared_ptr<vfs::Backing> backing; //!< The backing of the IStorage, reads from it are prefetched asynchronously when they're sequential
 
       public:
         IStorage(std::shared_ptr<vfs::Backing> &backing, const DeviceState &state, ServiceManager &manager);
@@ -14,13 +14,44 @@ namespace skyline::service::hosbinder {
 
     GraphicBufferProducer::GraphicBufferProducer(const DeviceState &state) : state(state) {}
 
+    void GraphicBufferProducer::FreeSlot(u32 slot) {
+        auto &buffer{queue.at(slot)};
+        buffer->status = BufferStatus::Free;
+        freeSlots[BufferKey{buffer->gbpBuffer.format, buffer->gbpBuffer.width, buffer->gbpBuffer.height}].push_back(slot);
+        slotFreed.notify_all();
+    }
+
+    void GraphicBufferProducer::RemoveFreeSlot(u32 slot, const Buffer &buffer) {
+        if (buffer.status != BufferStatus::Free)
+            return;
+
+        auto slots{freeSlots.find(BufferKey{buffer.gbpBuffer.format, buffer.gbpBuffer.width, buffer.gbpBuffer.height})};
+        if (slots != freeSlots.end())
+            std::erase(slots->second, slot);
+    }
+
+    std::shared_ptr<Buffer> &GraphicBufferProducer::GetBuffer(u32 slot, BufferStatus expected) {
+        auto buffer{queue.find(slot)};
+        if (buffer == queue.end())
+            throw exception("Slot {} doesn't have a buffer", slot);
+        if (buffer->second->status != expected)
+            throw exception("Buffer in slot {} is in state {} rather than {}", slot, static_cast<u32>(buffer->second->status), static_cast<u32>(expected));
+        return buffer->second;
+    }
+
     void GraphicBufferProducer::RequestBuffer(Parcel &in, Parcel &out) {
         u32 slot{in.Pop<u32>()};
 
+        GbpBuffer gbpBuffer;
+        {
+            std::lock_guard lock(queueMutex);
+            gbpBuffer = queue.at(slot)->gbpBuffer;
+        }
+
         out.Push<u32>(1);
         out.Push<u32>(sizeof(GbpBuffer));
         out.Push<u32>(0);
-        out.Push(queue.at(slot)->gbpBuffer);
+        out.Push(gbpBuffer);
 
         state.logger->Debug("RequestBuffer: Slot: {}", slot, sizeof(GbpBuffer));
     }
@@ -33,14 +64,27 @@ namespace skyline::service::hosbinder {
         u32 usage{in.Pop<u32>()};
 
         std::optional<u32> slot{std::nullopt};
-        while (!slot) {
-            for (auto &buffer : queue) {
-                if (buffer.second->status == BufferStatus::Free && buffer.second->gbpBuffer.format == format && buffer.second->gbpBuffer.width == width && buffer.second->gbpBuffer.height == height && (buffer.second->gbpBuffer.usage & usage) == usage) {
-                    slot = buffer.first;
-                    buffer.second->status = BufferStatus::Dequeued;
-                    break;
-                }
-            }
+        auto findSlot{[&]() {
+            auto slots{freeSlots.find(BufferKey{format, width, height})};
+            if (slots == freeSlots.end())
+                return false;
+
+            auto match{std::find_if(slots->second.begin(), slots->second.end(), [&](u32 freeSlot) {
+                return (queue.at(freeSlot)->gbpBuffer.usage & usage) == usage;
+            })};
+            if (match == slots->second.end())
+                return false;
+
+            slot = *match;
+            slots->second.erase(match);
+            return true;
+        }};
+
+        {
+            // The presentation thread frees buffers after they have been presented, this waits on that rather than spinning
+            std::unique_lock lock(queueMutex);
+            slotFreed.wait(lock, findSlot);
+            queue.at(*slot)->status = BufferStatus::Dequeued;
         }
 
         out.Push(*slot);
@@ -60,21 +104,31 @@ namespace skyline::service::hosbinder {
             u32 stickyTransform;
             u64 _unk0_;
             u32 swapInterval;
+            u32 fenceCount;
             nvdrv::Fence fence[4];
         } &data = in.Pop<Data>();
 
-        auto buffer = queue.at(data.slot);
-        buffer->status = BufferStatus::Queued;
+        std::shared_ptr<Buffer> buffer;
+        {
+            std::lock_guard lock(queueMutex);
+            buffer = GetBuffer(data.slot, BufferStatus::Dequeued);
+            buffer->status = BufferStatus::Queued;
+        }
 
         auto slot = data.slot;
         auto bufferEvent = state.gpu->bufferEvent;
-        buffer->texture->releaseCallback = [this, slot, bufferEvent]() {
-            queue.at(slot)->status = BufferStatus::Free;
+        buffer->texture->releaseCallback = [this, slot, bufferEvent, queued = buffer.get()]() {
+            {
+                // The slot could've been given a different buffer by SetPreallocatedBuffer while this one was being presented
+                std::lock_guard lock(queueMutex);
+                auto &current{queue.at(slot)};
+                if (current.get() == queued && current->status == BufferStatus::Queued)
+                    FreeSlot(slot);
+            }
             bufferEvent->Signal();
         };
 
-        buffer->texture->SynchronizeHost();
-        state.gpu->presentationQueue.push(buffer->texture);
+        state.gpu->QueuePresentation(buffer->texture, std::span(data.fence, std::min<u32>(data.fenceCount, 4)));
 
         struct {
             u32 width;
@@ -93,7 +147,11 @@ namespace skyline::service::hosbinder {
         u32 slot{in.Pop<u32>()};
         //auto fences{in.Pop<std::array<nvdrv::Fence, 4>>()};
 
-        queue.at(slot)->status = BufferStatus::Free;
+        {
+            std::lock_guard lock(queueMutex);
+            GetBuffer(slot, BufferStatus::Dequeued);
+            FreeSlot(slot);
+        }
 
         state.logger->Debug("CancelBuffer: Slot: {}", slot);
     }
@@ -120,23 +178,12 @@ namespace skyline::service::hosbinder {
 
         auto& gbpBuffer = in.Pop<GbpBuffer>();
 
-        std::shared_ptr<nvdrv::device::NvMap::NvMapObject> nvBuffer{};
-
         auto driver = nvdrv::driver.lock();
         auto nvmap = driver->nvMap.lock();
 
-        if (gbpBuffer.nvmapHandle) {
-            nvBuffer = nvmap->handleTable.at(gbpBuffer.nvmapHandle);
-        } else {
-            for (const auto &object : nvmap->handleTable) {
-                if (object.second->id == gbpBuffer.nvmapId) {
-                    nvBuffer = object.second;
-                    break;
-                }
-            }
-            if (!nvBuffer)
-                throw exception("A QueueBuffer request has an invalid NVMap Handle ({}) and ID ({})", gbpBuffer.nvmapHandle, gbpBuffer.nvmapId);
-        }
+        auto nvBuffer{gbpBuffer.nvmapHandle ? nvmap->GetObject(gbpBuffer.nvmapHandle) : nvmap->GetObjectFromId(gbpBuffer.nvmapId)};
+        if (!nvBuffer)
+            throw exception("A QueueBuffer request has an invalid NVMap Handle ({}) and ID ({})", gbpBuffer.nvmapHandle, gbpBuffer.nvmapId);
 
         gpu::texture::Format format;
         switch (gbpBuffer.format) {
@@ -153,7 +200,15 @@ namespace skyline::service::hosbinder {
 
         auto texture = std::make_shared<gpu::GuestTexture>(state, nvBuffer->address + gbpBuffer.offset, gpu::texture::Dimensions(gbpBuffer.width, gbpBuffer.height), format, gpu::texture::TileMode::Block, gpu::texture::TileConfig{.surfaceWidth = static_cast<u16>(gbpBuffer.stride), .blockHeight = static_cast<u8>(1U << gbpBuffer.blockHeightLog2), .blockDepth = 1});
 
-        queue[data.slot] = std::make_shared<Buffer>(gbpBuffer, texture->InitializePresentationTexture());
+        {
+            std::lock_guard lock(queueMutex);
+            auto &buffer{queue[data.slot]};
+            if (buffer)
+                RemoveFreeSlot(data.slot, *buffer);
+
+            buffer = std::make_shared<Buffer>(gbpBuffer, texture->InitializePresentationTexture());
+            FreeSlot(data.slot);
+        }
         state.gpu->bufferEvent->Signal();
 
         state.logger->Debug("SetPreallocatedBuffer: Slot: {}, Magic: 0x{:X}, Width: {}, Height: {}, Stride: {}, Format: {}, Usage: {}, Index: {}, ID: {}, Handle: {}, Offset: 0x{:X}, Block Height: {}, Size: 0x{:X}", data.slot, gbpBuffer.magic, gbpBuffer.width, gbpBuffer.height, gbpBuffer.stride, gbpBuffer.format, gbpBuffer.usage, gbpBuffer.index, gbpBuffer.nvmapId, gbpBuffer.nvmapHandle, gbpBuffer.offset, (1U << gbpBuffer.blockHeightLog2), gbpBuffer.size);
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <deque>
+#include <condition_variable>
 #include <gpu.h>
 #include <services/common/parcel.h>
 
@@ -31,12 +33,26 @@ namespace skyline::service::hosbinder {
         u32 _pad5_[58];
     };
 
+    /**
+     * @brief The states a buffer goes through, a buffer is dequeued when it's free, queued or cancelled when it's dequeued and freed once it has been presented
+     */
     enum class BufferStatus {
         Free, //!< The buffer is free
         Dequeued, //!< The buffer has been dequeued from the display
         Queued, //!< The buffer is queued to be displayed
     };
 
+    /**
+     * @brief The attributes free buffers are indexed by, DequeueBuffer requests a buffer with specific attributes
+     */
+    struct BufferKey {
+        u32 format;
+        u32 width;
+        u32 height;
+
+        auto operator<=>(const BufferKey &) const = default;
+    };
+
     /**
      * @brief A wrapper over GbpBuffer which contains additional state that we track for a buffer
      */
@@ -72,7 +88,28 @@ namespace skyline::service::hosbinder {
     class GraphicBufferProducer {
       private:
         const DeviceState &state;
-        std::unordered_map<u32, std::shared_ptr<Buffer>> queue; //!< A vector of shared pointers to all the queued buffers
+        std::unordered_map<u32, std::shared_ptr<Buffer>> queue; //!< A mapping from a slot to its buffer
+        std::map<BufferKey, std::deque<u32>> freeSlots; //!< The slots of free buffers indexed by their attributes, these are in the order they were freed in
+        std::mutex queueMutex; //!< Synchronizes access to the buffers as they're freed by the presentation thread
+        std::condition_variable slotFreed; //!< Signalled whenever a slot is freed, DequeueBuffer waits on this when there are no matching free slots
+
+        /**
+         * @brief Frees the buffer in a slot and makes it available to DequeueBuffer
+         * @note queueMutex must be locked when calling this
+         */
+        void FreeSlot(u32 slot);
+
+        /**
+         * @brief Removes a slot from the index of free slots
+         * @note queueMutex must be locked when calling this
+         */
+        void RemoveFreeSlot(u32 slot, const Buffer &buffer);
+
+        /**
+         * @return The buffer in a slot which has to be in the expected state
+         * @note queueMutex must be locked when calling this
+         */
+        std::shared_ptr<Buffer> &GetBuffer(u32 slot, BufferStatus expected);
 
         /**
          * @brief Request for the GbpBuffer of a buffer
@@ -80,7 +117,7 @@ namespace skyline::service::hosbinder {
         void RequestBuffer(Parcel &in, Parcel &out);
 
         /**
-         * @brief Try to dequeue a free graphics buffer that has been consumed
+         * @brief Dequeue a free graphics buffer that has been consumed, this blocks till a matching buffer is freed if there are none
          */
         void DequeueBuffer(Parcel &in, Parcel &out);
 
@@ -29,18 +29,21 @@ namespace skyline::service::nvdrv::device {
             }
         }()};
 
-        std::pair<std::function<NvStatus(IoctlType, std::span<u8>, std::span<u8>)>, std::string_view> function;
+        // The name of the IOCTL is only looked up when it's going to be logged
+        if (state.logger->configLevel >= Logger::LogLevel::Debug)
+            state.logger->Debug("{} @ {}: {}", typeString, GetName(), GetIoctlName(cmd));
+
+        std::optional<NvStatus> status;
         try {
-            function = GetIoctlFunction(cmd);
-            state.logger->Debug("{} @ {}: {}", typeString, GetName(), function.second);
-        } catch (std::out_of_range &) {
+            status = CallIoctl(cmd, type, buffer, inlineBuffer);
+        } catch (const std::exception &e) {
+            throw exception("{} ({} @ {}: {})", e.what(), typeString, GetName(), GetIoctlName(cmd));
+        }
+
+        if (!status) {
             state.logger->Warn("Cannot find IOCTL for device '{}': 0x{:X}", GetName(), cmd);
             return NvStatus::NotImplemented;
         }
-        try {
-            return function.first(type, buffer, inlineBuffer);
-        } catch (const std::exception &e) {
-            throw exception("{} ({} @ {}: {})", e.what(), typeString, GetName(), function.second);
-        }
+        return *status;
     }
 }
@@ -8,13 +8,19 @@
 #include <kernel/ipc.h>
 #include <kernel/types/KEvent.h>
 
-#define NVFUNC(id, Class, Function) std::pair<u32, std::pair<std::function<NvStatus(Class*, IoctlType, std::span<u8>, std::span<u8>)>, std::string_view>>{id, {&Class::Function, #Function}}
+#define NVFUNC(id, Class, Function) std::pair<u32, std::pair<NvStatus (Class::*)(IoctlType, std::span<u8>, std::span<u8>), std::string_view>>{id, {&Class::Function, #Function}}
 #define NVDEVICE_DECL_AUTO(name, value) decltype(value) name = value
-#define NVDEVICE_DECL(...)                                                                                                                        \
-NVDEVICE_DECL_AUTO(functions, frz::make_unordered_map({__VA_ARGS__}));                                                                            \
-std::pair<std::function<NvStatus(IoctlType, std::span<u8>, std::span<u8>)>, std::string_view> GetIoctlFunction(u32 id) {                          \
-    auto& function = functions.at(id);                                                                                                            \
-    return std::make_pair(std::bind(function.first, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), function.second); \
+#define NVDEVICE_DECL(...)                                                                                                \
+NVDEVICE_DECL_AUTO(functions, frz::make_unordered_map({__VA_ARGS__}));                                                    \
+std::optional<NvStatus> CallIoctl(u32 id, IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) {             \
+    auto function{functions.find(id)};                                                                                    \
+    if (function == functions.end())                                                                                      \
+        return std::nullopt;                                                                                              \
+    return (this->*function->second.first)(type, buffer, inlineBuffer);                                                   \
+}                                                                                                                         \
+std::string_view GetIoctlName(u32 id) {                                                                                   \
+    auto function{functions.find(id)};                                                                                    \
+    return (function != functions.end()) ? function->second.second : std::string_view{};                                  \
 }
 
 namespace skyline::service::nvdrv::device {
@@ -73,7 +79,17 @@ namespace skyline::service::nvdrv::device {
 
         virtual ~NvDevice() = default;
 
-        virtual std::pair<std::function<NvStatus(IoctlType, std::span<u8>, std::span<u8>)>, std::string_view> GetIoctlFunction(u32 id) = 0;
+        /**
+         * @brief Calls the member function corresponding to an IOCTL directly through a member function pointer
+         * @return The result of the IOCTL or std::nullopt if the device doesn't have an IOCTL with the ID
+         */
+        virtual std::optional<NvStatus> CallIoctl(u32 id, IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) = 0;
+
+        /**
+         * @return The name of an IOCTL or an empty string if the device doesn't have an IOCTL with the ID
+         * @note This is only meant to be used for logging as it requires an additional lookup
+         */
+        virtual std::string_view GetIoctlName(u32 id) = 0;
 
         /**
          * @return The name of the class
@@ -62,29 +62,28 @@ namespace skyline::service::nvdrv::device {
             u64 offset;       // InOut
         }  &data = util::As<Data>(buffer);
 
-        try {
-            auto driver = nvdrv::driver.lock();
-            auto nvmap = driver->nvMap.lock();
-            auto mapping = nvmap->handleTable.at(data.nvmapHandle);
-
-            u64 mapPhysicalAddress = data.bufferOffset + mapping->address;
-            u64 mapSize = data.mappingSize ? data.mappingSize : mapping->size;
+        auto driver = nvdrv::driver.lock();
+        auto nvmap = driver->nvMap.lock();
+        auto mapping = nvmap->GetObject(data.nvmapHandle);
+        if (!mapping) {
+            state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.nvmapHandle);
+            return NvStatus::BadParameter;
+        }
 
-            if (data.flags & 1)
-                data.offset = state.gpu->memoryManager.MapFixed(data.offset, mapPhysicalAddress, mapSize);
-            else
-                data.offset = state.gpu->memoryManager.MapAllocate(mapPhysicalAddress, mapSize);
+        u64 mapPhysicalAddress = data.bufferOffset + mapping->address;
+        u64 mapSize = data.mappingSize ? data.mappingSize : mapping->size;
 
-            if (data.offset == 0) {
-                state.logger->Warn("Failed to map GPU address space region!");
-                return NvStatus::BadParameter;
-            }
+        if (data.flags & 1)
+            data.offset = state.gpu->memoryManager.MapFixed(data.offset, mapPhysicalAddress, mapSize);
+        else
+            data.offset = state.gpu->memoryManager.MapAllocate(mapPhysicalAddress, mapSize);
 
-            return NvStatus::Success;
-        } catch (const std::out_of_range &) {
-            state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.nvmapHandle);
+        if (data.offset == 0) {
+            state.logger->Warn("Failed to map GPU address space region!");
             return NvStatus::BadParameter;
         }
+
+        return NvStatus::Success;
     }
 
     NvStatus NvHostAsGpu::GetVaRegions(IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) {
@@ -132,22 +131,22 @@ namespace skyline::service::nvdrv::device {
 
         constexpr u32 MinAlignmentShift{0x10}; // This shift is applied to all addresses passed to Remap
 
+        auto driver = nvdrv::driver.lock();
+        auto nvmap = driver->nvMap.lock();
+
         auto entries{util::AsSpan<Entry>(buffer)};
         for (auto entry : entries) {
-            try {
-                auto driver = nvdrv::driver.lock();
-                auto nvmap = driver->nvMap.lock();
-                auto mapping = nvmap->handleTable.at(entry.nvmapHandle);
-
-                u64 mapAddress = static_cast<u64>(entry.gpuOffset) << MinAlignmentShift;
-                u64 mapPhysicalAddress = mapping->address + (static_cast<u64>(entry.mapOffset) << MinAlignmentShift);
-                u64 mapSize = static_cast<u64>(entry.pages) << MinAlignmentShift;
-
-                state.gpu->memoryManager.MapFixed(mapAddress, mapPhysicalAddress, mapSize);
-            } catch (const std::out_of_range &) {
+            auto mapping = nvmap->GetObject(entry.nvmapHandle);
+            if (!mapping) {
                 state.logger->Warn("Invalid NvMap handle: 0x{:X}", entry.nvmapHandle);
                 return NvStatus::BadParameter;
             }
+
+            u64 mapAddress = static_cast<u64>(entry.gpuOffset) << MinAlignmentShift;
+            u64 mapPhysicalAddress = mapping->address + (static_cast<u64>(entry.mapOffset) << MinAlignmentShift);
+            u64 mapSize = static_cast<u64>(entry.pages) << MinAlignmentShift;
+
+            state.gpu->memoryManager.MapFixed(mapAddress, mapPhysicalAddress, mapSize);
         }
 
         return NvStatus::Success;
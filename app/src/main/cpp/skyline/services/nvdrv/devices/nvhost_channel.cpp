@@ -54,7 +54,10 @@ namespace skyline::service::nvdrv::device {
                 throw exception("Waiting on a fence through SubmitGpfifo is unimplemented");
         }
 
-        state.gpu->gpfifo.Push(std::span(state.process->GetPointer<gpu::gpfifo::GpEntry>(data.address), data.numEntries));
+        std::span entries(state.process->GetPointer<gpu::gpfifo::GpEntry>(data.address), data.numEntries);
+        if (state.gpu->recorder)
+            state.gpu->recorder->RecordSubmission(entries, state.gpu->memoryManager);
+        state.gpu->gpfifo.Push(entries);
 
         data.fence.id = channelFence.id;
 
@@ -9,14 +9,48 @@ namespace skyline::service::nvdrv::device {
 
     NvMap::NvMap(const DeviceState &state) : NvDevice(state) {}
 
+    std::shared_ptr<NvMap::NvMapObject> NvMap::GetObject(KHandle handle) {
+        std::lock_guard lock(tableLock);
+        if (handle == 0 || handle > handleTable.size())
+            return nullptr;
+        return handleTable[handle - 1];
+    }
+
+    std::shared_ptr<NvMap::NvMapObject> NvMap::GetObjectFromId(u32 id) {
+        std::lock_guard lock(tableLock);
+        if (id == 0 || id > idTable.size() || idTable[id - 1] == 0)
+            return nullptr;
+        return handleTable[idTable[id - 1] - 1];
+    }
+
     NvStatus NvMap::Create(IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) {
         struct Data {
             u32 size;   // In
             u32 handle; // Out
         } &data = util::As<Data>(buffer);
 
-        handleTable[handleIndex] = std::make_shared<NvMapObject>(idIndex++, data.size);
-        data.handle = handleIndex++;
+        std::lock_guard lock(tableLock);
+
+        // Handles and IDs are 1-based indices into their tables, the slots of freed ones are reused first
+        u32 id;
+        if (!freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+        } else {
+            idTable.push_back(0);
+            id = static_cast<u32>(idTable.size());
+        }
+
+        if (!freeHandles.empty()) {
+            data.handle = freeHandles.back();
+            freeHandles.pop_back();
+        } else {
+            handleTable.emplace_back();
+            data.handle = static_cast<KHandle>(handleTable.size());
+        }
+
+        handleTable[data.handle - 1] = std::make_shared<NvMapObject>(id, data.size);
+        idTable[id - 1] = data.handle;
 
         state.logger->Debug("Size: 0x{:X} -> Handle: 0x{:X}", data.size, data.handle);
         return NvStatus::Success;
@@ -28,9 +62,10 @@ namespace skyline::service::nvdrv::device {
             u32 handle; // Out
         } &data = util::As<Data>(buffer);
 
-        for (const auto &object : handleTable) {
-            if (object.second->id == data.id) {
-                data.handle = object.first;
+        {
+            std::lock_guard lock(tableLock);
+            if (data.id && data.id <= idTable.size() && idTable[data.id - 1]) {
+                data.handle = idTable[data.id - 1];
                 state.logger->Debug("ID: 0x{:X} -> Handle: 0x{:X}", data.id, data.handle);
                 return NvStatus::Success;
             }
@@ -51,21 +86,21 @@ namespace skyline::service::nvdrv::device {
             u64 address;  // InOut
         } &data = util::As<Data>(buffer);
 
-        try {
-            auto &object = handleTable.at(data.handle);
-            object->heapMask = data.heapMask;
-            object->flags = data.flags;
-            object->align = data.align;
-            object->kind = data.kind;
-            object->address = data.address;
-            object->status = NvMapObject::Status::Allocated;
-
-            state.logger->Debug("Handle: 0x{:X}, HeapMask: 0x{:X}, Flags: {}, Align: 0x{:X}, Kind: {}, Address: 0x{:X}", data.handle, data.heapMask, data.flags, data.align, data.kind, data.address);
-            return NvStatus::Success;
-        } catch (const std::out_of_range &) {
+        auto object{GetObject(data.handle)};
+        if (!object) {
             state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.handle);
             return NvStatus::BadParameter;
         }
+
+        object->heapMask = data.heapMask;
+        object->flags = data.flags;
+        object->align = data.align;
+        object->kind = data.kind;
+        object->address = data.address;
+        object->status = NvMapObject::Status::Allocated;
+
+        state.logger->Debug("Handle: 0x{:X}, HeapMask: 0x{:X}, Flags: {}, Align: 0x{:X}, Kind: {}, Address: 0x{:X}", data.handle, data.heapMask, data.flags, data.align, data.kind, data.address);
+        return NvStatus::Success;
     }
 
     NvStatus NvMap::Free(IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) {
@@ -77,25 +112,33 @@ namespace skyline::service::nvdrv::device {
             u32 flags;    // Out
         } &data = util::As<Data>(buffer);
 
-        try {
-            const auto &object = handleTable.at(data.handle);
-            if (object.use_count() > 1) {
-                data.address = static_cast<u32>(object->address);
-                data.flags = 0x0;
-            } else {
-                data.address = 0x0;
-                data.flags = 0x1; // Not free yet
+        std::shared_ptr<NvMapObject> object;
+        {
+            std::lock_guard lock(tableLock);
+            if (data.handle == 0 || data.handle > handleTable.size() || !handleTable[data.handle - 1]) {
+                state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.handle);
+                return NvStatus::BadParameter;
             }
 
-            data.size = object->size;
-            handleTable.erase(data.handle);
+            // The slots are released for reuse while any references held elsewhere keep the object itself alive
+            object = std::move(handleTable[data.handle - 1]);
+            idTable[object->id - 1] = 0;
+            freeHandles.push_back(data.handle);
+            freeIds.push_back(object->id);
+        }
 
-            state.logger->Debug("Handle: 0x{:X} -> Address: 0x{:X}, Size: 0x{:X}, Flags: 0x{:X}", data.handle, data.address, data.size, data.flags);
-            return NvStatus::Success;
-        } catch (const std::out_of_range &) {
-            state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.handle);
-            return NvStatus::BadParameter;
+        if (object.use_count() > 1) {
+            data.address = static_cast<u32>(object->address);
+            data.flags = 0x0;
+        } else {
+            data.address = 0x0;
+            data.flags = 0x1; // Not free yet
         }
+
+        data.size = object->size;
+
+        state.logger->Debug("Handle: 0x{:X} -> Address: 0x{:X}, Size: 0x{:X}, Flags: 0x{:X}", data.handle, data.address, data.size, data.flags);
+        return NvStatus::Success;
     }
 
     NvStatus NvMap::Param(IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) {
@@ -106,41 +149,40 @@ namespace skyline::service::nvdrv::device {
             u32 result;          // Out
         } &data = util::As<Data>(buffer);
 
-        try {
-            auto &object = handleTable.at(data.handle);
-
-            switch (data.parameter) {
-                case Parameter::Size:
-                    data.result = object->size;
-                    break;
+        auto object{GetObject(data.handle)};
+        if (!object) {
+            state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.handle);
+            return NvStatus::BadParameter;
+        }
 
-                case Parameter::Alignment:
-                    data.result = object->align;
-                    break;
+        switch (data.parameter) {
+            case Parameter::Size:
+                data.result = object->size;
+                break;
 
-                case Parameter::HeapMask:
-                    data.result = object->heapMask;
-                    break;
+            case Parameter::Alignment:
+                data.result = object->align;
+                break;
 
-                case Parameter::Kind:
-                    data.result = object->kind;
-                    break;
+            case Parameter::HeapMask:
+                data.result = object->heapMask;
+                break;
 
-                case Parameter::Compr:
-                    data.result = 0;
-                    break;
+            case Parameter::Kind:
+                data.result = object->kind;
+                break;
 
-                default:
-                    state.logger->Warn("Parameter not implemented: 0x{:X}", data.parameter);
-                    return NvStatus::NotImplemented;
-            }
+            case Parameter::Compr:
+                data.result = 0;
+                break;
 
-            state.logger->Debug("Handle: 0x{:X}, Parameter: {} -> Result: 0x{:X}", data.handle, data.parameter, data.result);
-            return NvStatus::Success;
-        } catch (const std::out_of_range &) {
-            state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.handle);
-            return NvStatus::BadParameter;
+            default:
+                state.logger->Warn("Parameter not implemented: 0x{:X}", data.parameter);
+                return NvStatus::NotImplemented;
         }
+
+        state.logger->Debug("Handle: 0x{:X}, Parameter: {} -> Result: 0x{:X}", data.handle, data.parameter, data.result);
+        return NvStatus::Success;
     }
 
     NvStatus NvMap::GetId(IoctlType type, std::span<u8> buffer, std::span<u8> inlineBuffer) {
@@ -149,13 +191,14 @@ namespace skyline::service::nvdrv::device {
             u32 handle; // In
         } &data = util::As<Data>(buffer);
 
-        try {
-            data.id = handleTable.at(data.handle)->id;
-            state.logger->Debug("Handle: 0x{:X} -> ID: 0x{:X}", data.handle, data.id);
-            return NvStatus::Success;
-        } catch (const std::out_of_range &) {
+        auto object{GetObject(data.handle)};
+        if (!object) {
             state.logger->Warn("Invalid NvMap handle: 0x{:X}", data.handle);
             return NvStatus::BadParameter;
         }
+
+        data.id = object->id;
+        state.logger->Debug("Handle: 0x{:X} -> ID: 0x{:X}", data.handle, data.id);
+        return NvStatus::Success;
     }
 }
@@ -10,6 +10,16 @@ namespace skyline::service::nvdrv::device {
      * @brief NvMap (/dev/nvmap) is used to map certain CPU memory as GPU memory (https://switchbrew.org/wiki/NV_services) (https://android.googlesource.com/kernel/tegra/+/refs/heads/android-tegra-flounder-3.10-marshmallow/include/linux/nvmap.h)
      */
     class NvMap : public NvDevice {
+      public:
+        struct NvMapObject;
+
+      private:
+        std::vector<std::shared_ptr<NvMapObject>> handleTable; //!< The objects indexed by their handle minus one, the slots of freed objects are empty till they're reused
+        std::vector<KHandle> idTable; //!< The handles of objects indexed by their ID minus one, the slots of freed IDs are 0
+        std::vector<KHandle> freeHandles; //!< The handles of freed objects, these are reused before the table is grown
+        std::vector<u32> freeIds; //!< The IDs of freed objects, these are reused before the table is grown
+        Mutex tableLock; //!< Synchronizes accesses to the tables as objects are also looked up by other devices and services
+
       public:
         /**
          * @brief NvMapObject is used to hold the state of held objects
@@ -35,12 +45,20 @@ namespace skyline::service::nvdrv::device {
             NvMapObject(u32 id, u32 size);
         };
 
-        std::unordered_map<KHandle, std::shared_ptr<NvMapObject>> handleTable; //!< A mapping from a handle to it's corresponding NvMapObject
-        KHandle handleIndex{1}; //!< This is used to keep track of the next handle to allocate
-        u32 idIndex{1}; //!< This is used to keep track of the next ID to allocate
-
         NvMap(const DeviceState &state);
 
+        /**
+         * @return The object with the specified handle or nullptr if the handle is invalid
+         * @note The returned reference keeps the object alive even if it's freed in the meantime
+         */
+        std::shared_ptr<NvMapObject> GetObject(KHandle handle);
+
+        /**
+         * @return The object with the specified ID or nullptr if the ID is invalid
+         * @note The returned reference keeps the object alive even if it's freed in the meantime
+         */
+        std::shared_ptr<NvMapObject> GetObjectFromId(u32 id);
+
         /**
          * @brief This creates an NvMapObject and returns an handle to it (https://switchbrew.org/wiki/NV_services#NVMAP_IOC_CREATE)
          */
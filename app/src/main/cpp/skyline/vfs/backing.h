@@ -62,6 +62,14 @@ namespace skyline::vfs {
             return Read(reinterpret_cast<u8 *>(output), offset, size ? size : sizeof(T));
         }
 
+        /**
+         * @return A pointer to the contents of the backing if they're mapped into memory and nullptr otherwise, this allows reading without any copies
+         * @note The mapping is only valid for size bytes and for the lifetime of the backing
+         */
+        virtual u8 *GetMapping() {
+            return nullptr;
+        }
+
         /**
          * @brief Writes from a buffer to a particular offset in the backing
          * @param input The object to write to the backing
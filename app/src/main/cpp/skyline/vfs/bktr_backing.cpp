@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "bktr_backing.h"
+
+namespace skyline::vfs {
+    BktrBacking::BktrBacking(std::shared_ptr<Backing> pBase, size_t baseRomFsOffset, std::shared_ptr<CtrEncryptedBacking> pPatch, const PatchInfo &patchInfo, u32 generation) : base(std::move(pBase)), baseRomFsOffset(baseRomFsOffset), patch(std::move(pPatch)) {
+        u64 patchedSize, subsectionSize;
+        relocations = ReadTable<RelocationEntry>(patchInfo.relocation, patchedSize);
+        subsections = ReadTable<SubsectionEntry>(patchInfo.subsection, subsectionSize);
+        size = patchedSize;
+
+        // The tables at the end of the section are encrypted with the generation of the section rather than one from the subsections, the last entry terminates the final subsection
+        subsections.push_back(SubsectionEntry{patchInfo.relocation.offset, 0, generation});
+        subsections.push_back(SubsectionEntry{patch->size, 0, 0});
+
+        if (relocations.empty() || relocations.front().patchedOffset != 0)
+            throw exception("BKTR relocation table doesn't start at the beginning of the section");
+        if (!std::is_sorted(relocations.begin(), relocations.end(), [](const RelocationEntry &a, const RelocationEntry &b) { return a.patchedOffset < b.patchedOffset; }))
+            throw exception("BKTR relocation table isn't sorted");
+        if (!std::is_sorted(subsections.begin(), subsections.end(), [](const SubsectionEntry &a, const SubsectionEntry &b) { return a.offset < b.offset; }))
+            throw exception("BKTR subsection table isn't sorted");
+    }
+
+    template<typename EntryType>
+    std::vector<EntryType> BktrBacking::ReadTable(const BucketTreeHeader &header, u64 &tableSize) {
+        if (header.magic != util::MakeMagic<u32>("BKTR"))
+            throw exception("BKTR table has an invalid magic: 0x{:X}", header.magic);
+        if (header.size < BucketSize || header.offset + header.size > patch->size)
+            throw exception("BKTR table at 0x{:X} is out of bounds", header.offset);
+
+        // The table is read in its entirety as it is decrypted only once here
+        std::vector<u8> table(header.size);
+        if (patch->Read(table.data(), header.offset, table.size()) != table.size())
+            throw exception("BKTR table at 0x{:X} is truncated", header.offset);
+
+        TableHeader tableHeader;
+        std::memcpy(&tableHeader, table.data(), sizeof(TableHeader));
+        if ((static_cast<size_t>(tableHeader.bucketCount) + 1) * BucketSize > table.size())
+            throw exception("BKTR table at 0x{:X} has more buckets than fit into it: {}", header.offset, tableHeader.bucketCount);
+        tableSize = tableHeader.size;
+
+        constexpr size_t MaxBucketEntries{(BucketSize - sizeof(BucketHeader)) / sizeof(EntryType)};
+        std::vector<EntryType> entries;
+        entries.reserve(header.entryCount);
+        for (size_t index{}; index < tableHeader.bucketCount; index++) {
+            auto bucket{table.data() + (index + 1) * BucketSize};
+
+            BucketHeader bucketHeader;
+            std::memcpy(&bucketHeader, bucket, sizeof(BucketHeader));
+            if (bucketHeader.entryCount > MaxBucketEntries)
+                throw exception("BKTR bucket {} has more entries than fit into it: {}", index, bucketHeader.entryCount);
+
+            auto bucketEntries{reinterpret_cast<const EntryType *>(bucket + sizeof(BucketHeader))};
+            entries.insert(entries.end(), bucketEntries, bucketEntries + bucketHeader.entryCount);
+        }
+
+        return entries;
+    }
+
+    size_t BktrBacking::ReadPatch(u8 *output, size_t offset, size_t size) {
+        size_t read{};
+        while (read < size) {
+            auto position{offset + read};
+
+            // The subsection containing the position is the last one starting at or before it
+            auto next{std::upper_bound(subsections.begin(), subsections.end(), position, [](size_t position, const SubsectionEntry &entry) { return position < entry.offset; })};
+            if (next == subsections.begin() || next == subsections.end())
+                break;
+            const auto &subsection{*std::prev(next)};
+
+            auto chunkSize{std::min(size - read, next->offset - position)};
+            auto chunkRead{patch->ReadWithGeneration(output + read, position, chunkSize, subsection.generation)};
+            read += chunkRead;
+            if (chunkRead != chunkSize)
+                break;
+        }
+
+        return read;
+    }
+
+    size_t BktrBacking::Read(u8 *output, size_t offset, size_t size) {
+        if (offset >= this->size)
+            return 0;
+        size = std::min(size, this->size - offset);
+
+        size_t read{};
+        while (read < size) {
+            auto position{offset + read};
+
+            // The relocation containing the position is the last one starting at or before it, the first relocation always starts at 0
+            auto next{std::upper_bound(relocations.begin(), relocations.end(), position, [](size_t position, const RelocationEntry &entry) { return position < entry.patchedOffset; })};
+            const auto &relocation{*std::prev(next)};
+
+            auto chunkSize{std::min(size - read, (next != relocations.end() ? next->patchedOffset : this->size) - position)};
+            u64 sourceOffset{relocation.sourceOffset + (position - relocation.patchedOffset)};
+
+            size_t chunkRead;
+            if (relocation.fromPatch) {
+                chunkRead = ReadPatch(output + read, sourceOffset, chunkSize);
+            } else {
+                if (sourceOffset < baseRomFsOffset)
+                    throw exception("BKTR relocation at 0x{:X} points outside of the base RomFS", static_cast<u64>(relocation.patchedOffset));
+                chunkRead = base->Read(output + read, sourceOffset - baseRomFsOffset, chunkSize);
+            }
+
+            read += chunkRead;
+            if (chunkRead != chunkSize)
+                break;
+        }
+
+        return read;
+    }
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include "ctr_encrypted_backing.h"
+
+namespace skyline::vfs {
+    /**
+     * @brief The BktrBacking class provides the indirect storage of a BKTR patch section, it combines data from the section being patched with data from the patch section (https://switchbrew.org/wiki/NCA_Format#RomFS_Patching)
+     * @note The relocation and subsection tables are decrypted and flattened into sorted arrays once so a lookup is a single binary search, reads must be serialized by the caller as the patch backing isn't thread-safe
+     */
+    class BktrBacking : public Backing {
+      public:
+        /**
+         * @brief The header of a bucket tree table in the section header of a BKTR section
+         */
+        struct BucketTreeHeader {
+            u64 offset; //!< The offset of the table from the start of the section
+            u64 size; //!< The size of the table
+            u32 magic; //!< The magic of the table: 'BKTR'
+            u32 version; //!< The version of the table
+            u32 entryCount; //!< The total amount of entries in the table
+            u32 _pad_;
+        };
+        static_assert(sizeof(BucketTreeHeader) == 0x20);
+
+        /**
+         * @brief The patch info in the section header of a BKTR section
+         */
+        struct PatchInfo {
+            BucketTreeHeader relocation; //!< The table mapping offsets in the patched section to either the base or the patch section
+            BucketTreeHeader subsection; //!< The table of the AES-CTR generations of regions in the patch section
+        };
+        static_assert(sizeof(PatchInfo) == 0x40);
+
+      private:
+        constexpr static size_t BucketSize{0x4000}; //!< The size of a single bucket in a table, the first bucket-sized block of a table lists the start of every bucket
+
+        /**
+         * @brief The header of a bucket tree table
+         */
+        struct TableHeader {
+            u32 _pad_;
+            u32 bucketCount; //!< The amount of buckets after the header
+            u64 size; //!< The total size of the region described by the table
+        };
+
+        /**
+         * @brief The header of a single bucket in a table
+         */
+        struct BucketHeader {
+            u32 _pad_;
+            u32 entryCount; //!< The amount of entries in the bucket
+            u64 endOffset; //!< The end of the region described by the bucket
+        };
+
+        /**
+         * @brief A relocation of a region of the patched section
+         */
+        struct __attribute__((packed)) RelocationEntry {
+            u64 patchedOffset; //!< The offset of the region in the patched section
+            u64 sourceOffset; //!< The offset of the region in its source section
+            u32 fromPatch; //!< If the source of the region is the patch section rather than the base section
+        };
+        static_assert(sizeof(RelocationEntry) == 0x14);
+
+        /**
+         * @brief A region of the patch section encrypted with a specific generation
+         */
+        struct SubsectionEntry {
+            u64 offset; //!< The offset of the region in the patch section
+            u32 _pad_;
+            u32 generation; //!< The generation in the AES-CTR counter of the region
+        };
+        static_assert(sizeof(SubsectionEntry) == 0x10);
+
+        std::shared_ptr<Backing> base; //!< The RomFS of the base section
+        size_t baseRomFsOffset; //!< The offset of the base RomFS inside the base section
+        std::shared_ptr<CtrEncryptedBacking> patch; //!< The entire patch section decrypted with the generation of the section
+        std::vector<RelocationEntry> relocations; //!< All relocations sorted by their offset in the patched section
+        std::vector<SubsectionEntry> subsections; //!< All subsections sorted by their offset, this includes the tables at the end of the section
+
+        /**
+         * @brief Reads a table from the patch section and flattens the entries of all of its buckets into a vector
+         */
+        template<typename EntryType>
+        std::vector<EntryType> ReadTable(const BucketTreeHeader &header, u64 &tableSize);
+
+        /**
+         * @brief Reads data from the patch section, decrypting every subsection with its own generation
+         */
+        size_t ReadPatch(u8 *output, size_t offset, size_t size);
+
+      public:
+        /**
+         * @param base The RomFS of the section being patched
+         * @param baseRomFsOffset The offset of the base RomFS inside the base section
+         * @param patch The entire patch section, decrypted with the generation of the section
+         * @param patchInfo The patch info of the patch section
+         * @param generation The generation of the patch section, this is used for the tables at the end of it
+         */
+        BktrBacking(std::shared_ptr<Backing> base, size_t baseRomFsOffset, std::shared_ptr<CtrEncryptedBacking> patch, const PatchInfo &patchInfo, u32 generation);
+
+        size_t Read(u8 *output, size_t offset, size_t size) override;
+    };
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "cached_backing.h"
+
+namespace skyline::vfs {
+    CachedBacking::CachedBacking(std::shared_ptr<Backing> pBacking, size_t budget, size_t blockSize) : Backing({true, false, false}, pBacking->size), backing(std::move(pBacking)), blockSize(blockSize), shardCapacity(std::max(budget / blockSize / ShardCount, static_cast<size_t>(1))) {
+        if (!blockSize)
+            throw exception("CachedBacking block size cannot be zero");
+    }
+
+    size_t CachedBacking::ReadBlock(size_t index, size_t blockOffset, u8 *output, size_t size) {
+        auto &shard{shards[index % ShardCount]};
+
+        std::unique_lock shardGuard(shard.mutex);
+        auto entry{shard.map.find(index)};
+        if (entry != shard.map.end()) {
+            shard.blocks.splice(shard.blocks.begin(), shard.blocks, entry->second);
+            auto &data{entry->second->data};
+            size = std::min(size, data.size() > blockOffset ? data.size() - blockOffset : 0);
+            std::memcpy(output, data.data() + blockOffset, size);
+            return size;
+        }
+
+        // The least recently used block is taken out of the cache prior to reading so its storage can be reused without allocating
+        std::vector<u8> data;
+        if (shard.blocks.size() >= shardCapacity) {
+            auto &evicted{shard.blocks.back()};
+            shard.map.erase(evicted.index);
+            data = std::move(evicted.data);
+            shard.blocks.pop_back();
+        }
+        shardGuard.unlock();
+
+        auto blockStart{index * blockSize};
+        auto expectedSize{std::min(blockSize, this->size - blockStart)};
+        data.resize(expectedSize);
+        {
+            std::lock_guard backingGuard(backingLock);
+            data.resize(backing->Read(data.data(), blockStart, data.size()));
+        }
+
+        size = std::min(size, data.size() > blockOffset ? data.size() - blockOffset : 0);
+        std::memcpy(output, data.data() + blockOffset, size);
+
+        // A short read is returned as-is but not cached, otherwise a failed read would keep failing until the block is evicted
+        if (data.size() != expectedSize)
+            return size;
+
+        shardGuard.lock();
+        if (!shard.map.contains(index)) {
+            shard.blocks.push_front(Block{index, std::move(data)});
+            shard.map.emplace(index, shard.blocks.begin());
+        }
+
+        return size;
+    }
+
+    size_t CachedBacking::Read(u8 *output, size_t offset, size_t size) {
+        if (offset >= this->size)
+            return 0;
+        size = std::min(size, this->size - offset);
+
+        auto firstBlock{offset / blockSize};
+        auto lastBlock{(offset + size - 1) / blockSize};
+        if (lastBlock - firstBlock >= BypassBlockCount) {
+            std::lock_guard backingGuard(backingLock);
+            return backing->Read(output, offset, size);
+        }
+
+        size_t read{};
+        while (read < size) {
+            auto position{offset + read};
+            auto blockOffset{position % blockSize};
+            auto copySize{std::min(size - read, blockSize - blockOffset)};
+
+            auto copied{ReadBlock(position / blockSize, blockOffset, output + read, copySize)};
+            read += copied;
+            if (copied != copySize)
+                break;
+        }
+
+        return read;
+    }
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <list>
+#include "backing.h"
+
+namespace skyline {
+    namespace constant {
+        constexpr size_t BackingCacheBudget{16 * 1024 * 1024}; //!< The default amount of memory a CachedBacking can use for cached blocks
+        constexpr size_t BackingCacheBlockSize{0x4000}; //!< The default size of a single cached block, this is a multiple of the AES-CTR block size
+    }
+
+    namespace vfs {
+        /**
+         * @brief The CachedBacking class caches aligned blocks of another backing in memory, this is used to avoid repeatedly reading and decrypting frequently accessed data
+         * @note The blocks are spread across multiple shards with their own locks and LRU lists so concurrent readers rarely contend, reads from the underlying backing are serialized as it might not be thread-safe
+         */
+        class CachedBacking : public Backing {
+          private:
+            static constexpr size_t ShardCount{8}; //!< The amount of independently locked shards, consecutive blocks are placed in consecutive shards
+            static constexpr size_t BypassBlockCount{16}; //!< Reads which span more than this amount of blocks are passed through to the backing as caching them would evict everything else
+
+            /**
+             * @brief A single cached block of the backing
+             */
+            struct Block {
+                size_t index; //!< The index of the block in the backing
+                std::vector<u8> data; //!< The contents of the block, this is shorter than the block size for the last block of the backing
+            };
+
+            /**
+             * @brief A set of blocks with an LRU list and a lock of its own
+             */
+            struct Shard {
+                std::mutex mutex;
+                std::list<Block> blocks; //!< The cached blocks, ordered from most to least recently used
+                std::unordered_map<size_t, std::list<Block>::iterator> map; //!< A mapping from the index of a block to its position in the LRU list
+            };
+
+            std::shared_ptr<Backing> backing; //!< The backing that is being cached
+            std::mutex backingLock; //!< Serializes reads from the underlying backing
+            size_t blockSize;
+            size_t shardCapacity; //!< The maximum amount of blocks in a single shard
+            std::array<Shard, ShardCount> shards;
+
+            /**
+             * @brief Copies a part of a block into the output, the block is read from the backing and inserted into the cache if it isn't cached already and was read in full
+             * @param index The index of the block
+             * @param blockOffset The offset of the data to copy inside the block
+             * @param output The buffer to copy the data into
+             * @param size The amount of bytes to copy
+             * @return The amount of bytes copied, this is only less than size if the backing ended early
+             */
+            size_t ReadBlock(size_t index, size_t blockOffset, u8 *output, size_t size);
+
+          public:
+            /**
+             * @param backing The backing to cache, this must be read-only
+             * @param budget The maximum amount of memory to use for cached blocks
+             * @param blockSize The size of a single cached block
+             */
+            CachedBacking(std::shared_ptr<Backing> backing, size_t budget = constant::BackingCacheBudget, size_t blockSize = constant::BackingCacheBlockSize);
+
+            size_t Read(u8 *output, size_t offset, size_t size) override;
+        };
+    }
+}
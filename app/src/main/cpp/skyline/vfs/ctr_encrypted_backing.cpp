@@ -4,45 +4,50 @@
 #include "ctr_encrypted_backing.h"
 
 namespace skyline::vfs {
-    constexpr size_t SectorSize = 0x10;
+    constexpr size_t SectorSize{0x10};
 
-    CtrEncryptedBacking::CtrEncryptedBacking(crypto::KeyStore::Key128 &ctr, crypto::KeyStore::Key128 &key, const std::shared_ptr<Backing> &backing, size_t baseOffset) : Backing({true, false, false}), ctr(ctr), cipher(key, MBEDTLS_CIPHER_AES_128_CTR), backing(backing), baseOffset(baseOffset) {}
+    CtrEncryptedBacking::CtrEncryptedBacking(crypto::KeyStore::Key128 &ctr, crypto::KeyStore::Key128 &key, const std::shared_ptr<Backing> &backing, size_t baseOffset) : Backing({true, false, false}, backing->size), ctr(ctr), cipher(key, MBEDTLS_CIPHER_AES_128_CTR), backing(backing), baseOffset(baseOffset) {}
 
-    void CtrEncryptedBacking::UpdateCtr(u64 offset) {
-        offset >>= 4;
-        size_t le{__builtin_bswap64(offset)};
-        std::memcpy(ctr.data() + 8, &le, 8);
-        cipher.SetIV(ctr);
+    std::array<u8, 0x10> CtrEncryptedBacking::GetCtr(u64 offset, u32 generation) {
+        auto counter{ctr};
+        u32 generationBE{__builtin_bswap32(generation)};
+        std::memcpy(counter.data() + 4, &generationBE, 4);
+        u64 blockIndex{__builtin_bswap64((baseOffset + offset) >> 4)};
+        std::memcpy(counter.data() + 8, &blockIndex, 8);
+        return counter;
     }
 
     size_t CtrEncryptedBacking::Read(u8 *output, size_t offset, size_t size) {
+        u32 generationBE;
+        std::memcpy(&generationBE, ctr.data() + 4, 4);
+        return ReadWithGeneration(output, offset, size, __builtin_bswap32(generationBE));
+    }
+
+    size_t CtrEncryptedBacking::ReadWithGeneration(u8 *output, size_t offset, size_t size, u32 generation) {
         if (size == 0)
             return 0;
 
+        // A leading partial block is decrypted separately, everything after it is block aligned and decrypted in a single pass as CTR doesn't require the trailing block to be complete
         size_t sectorOffset{offset % SectorSize};
-        if (sectorOffset == 0) {
-            UpdateCtr(baseOffset + offset);
-            size_t read{backing->Read(output, offset, size)};
-            if (read != size)
+        size_t headSize{};
+        if (sectorOffset) {
+            size_t sectorStart{offset - sectorOffset};
+            std::array<u8, SectorSize> block;
+            if (backing->Read(block.data(), sectorStart, SectorSize) != SectorSize)
                 return 0;
-            cipher.Decrypt({output, size});
-            return size;
+            cipher.CtrDecrypt(block, GetCtr(sectorStart, generation));
+
+            headSize = std::min(size, SectorSize - sectorOffset);
+            std::memcpy(output, block.data() + sectorOffset, headSize);
+            if (headSize == size)
+                return size;
         }
 
-        size_t sectorStart{offset - sectorOffset};
-        std::vector<u8> blockBuf(SectorSize);
-        size_t read{backing->Read(blockBuf.data(), sectorStart, SectorSize)};
-        if (read != SectorSize)
+        size_t bodySize{size - headSize};
+        if (backing->Read(output + headSize, offset + headSize, bodySize) != bodySize)
             return 0;
-        UpdateCtr(baseOffset + sectorStart);
-        cipher.Decrypt(blockBuf);
-        if (size + sectorOffset < SectorSize) {
-            std::memcpy(output, blockBuf.data() + sectorOffset, size);
-            return size;
-        }
+        cipher.CtrDecrypt({output + headSize, bodySize}, GetCtr(offset + headSize, generation));
 
-        size_t readInBlock{SectorSize - sectorOffset};
-        std::memcpy(output, blockBuf.data() + sectorOffset, readInBlock);
-        return readInBlock + Read(output + readInBlock, offset + readInBlock, size - readInBlock);
+        return size;
     }
 }
@@ -25,13 +25,21 @@ namespace skyline::vfs {
         size_t baseOffset;
 
         /**
-         * @brief Calculates IV based on the offset
+         * @brief Calculates the counter of the block at the specified offset
+         * @param offset The offset relative to the backing, this must be block aligned
+         * @param generation The generation to use in the counter
          */
-        void UpdateCtr(u64 offset);
+        std::array<u8, 0x10> GetCtr(u64 offset, u32 generation);
 
       public:
         CtrEncryptedBacking(crypto::KeyStore::Key128 &ctr, crypto::KeyStore::Key128 &key, const std::shared_ptr<Backing> &backing, size_t baseOffset);
 
         size_t Read(u8 *output, size_t offset, size_t size) override;
+
+        /**
+         * @brief Reads data which was encrypted with a different generation in the counter than the one the backing was created with, this is the case for the subsections of a BKTR patch section
+         * @param generation The generation of the data
+         */
+        size_t ReadWithGeneration(u8 *output, size_t offset, size_t size, u32 generation);
     };
 }
@@ -3,7 +3,10 @@
 
 #include <crypto/aes_cipher.h>
 #include <loader/loader.h>
+#include <profile.h>
 #include "ctr_encrypted_backing.h"
+#include "cached_backing.h"
+#include "bktr_backing.h"
 #include "region_backing.h"
 #include "partition_filesystem.h"
 #include "nca.h"
@@ -13,13 +16,15 @@
 namespace skyline::vfs {
     using namespace loader;
 
-    NCA::NCA(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore) : backing(backing), keyStore(keyStore) {
+    NCA::NCA(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, const NCA *baseNca) : backing(backing), keyStore(keyStore) {
         backing->Read(&header);
 
         if (header.magic != util::MakeMagic<u32>("NCA3")) {
             if (!keyStore->headerKey)
                 throw loader_exception(LoaderResult::MissingHeaderKey);
 
+            profile::ScopedTimer timer{profile::Stage::NcaHeader};
+
             crypto::AesCipher cipher(*keyStore->headerKey, MBEDTLS_CIPHER_AES_128_XTS);
 
             cipher.XtsDecrypt({reinterpret_cast<u8 *>(&header), sizeof(NcaHeader)}, 0, 0x200);
@@ -39,8 +44,10 @@ namespace skyline::vfs {
 
             if (sectionHeader.fsType == NcaSectionFsType::PFS0 && sectionHeader.hashType == NcaSectionHashType::HierarchicalSha256)
                 ReadPfs0(sectionHeader, sectionEntry);
-            else if (sectionHeader.fsType == NcaSectionFsType::RomFs && sectionHeader.hashType == NcaSectionHashType::HierarchicalIntegrity)
-                ReadRomFs(sectionHeader, sectionEntry);
+            else if (sectionHeader.fsType == NcaSectionFsType::RomFs && sectionHeader.hashType == NcaSectionHashType::HierarchicalIntegrity) {
+                ReadRomFs(sectionHeader, sectionEntry, baseNca);
+                romFsHash = header.sectionHashes.at(i);
+            }
         }
     }
 
@@ -61,13 +68,33 @@ namespace skyline::vfs {
         }
     }
 
-    void NCA::ReadRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry) {
-        size_t offset{static_cast<size_t>(entry.startOffset) * constant::MediaUnitSize + sectionHeader.integrityHashInfo.levels.back().offset};
+    void NCA::ReadRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry, const NCA *baseNca) {
+        if (sectionHeader.encryptionType == NcaSectionEncryptionType::BKTR && encrypted) {
+            // A patch RomFS only contains the data that was changed, it can't be read without the RomFS it patches
+            if (baseNca && baseNca->romFs)
+                ReadPatchRomFs(sectionHeader, entry, *baseNca);
+            return;
+        }
+
+        romFsOffset = sectionHeader.integrityHashInfo.levels.back().offset;
+        size_t offset{static_cast<size_t>(entry.startOffset) * constant::MediaUnitSize + romFsOffset};
         size_t size{sectionHeader.integrityHashInfo.levels.back().size};
 
         romFs = CreateBacking(sectionHeader, std::make_shared<RegionBacking>(backing, offset, size), offset);
     }
 
+    void NCA::ReadPatchRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry, const NCA &baseNca) {
+        size_t offset{static_cast<size_t>(entry.startOffset) * constant::MediaUnitSize};
+        size_t size{constant::MediaUnitSize * static_cast<size_t>(entry.endOffset - entry.startOffset)};
+
+        // The relocations address the entire section, so the BKTR backing is created over it and the RomFS is a region of that
+        auto patch{CreateCtrBacking(sectionHeader, std::make_shared<RegionBacking>(backing, offset, size), offset)};
+        auto bktr{std::make_shared<BktrBacking>(baseNca.romFs, baseNca.romFsOffset, std::move(patch), sectionHeader.patchInfo, sectionHeader.generation)};
+
+        romFsOffset = sectionHeader.integrityHashInfo.levels.back().offset;
+        romFs = std::make_shared<CachedBacking>(std::make_shared<RegionBacking>(bktr, romFsOffset, sectionHeader.integrityHashInfo.levels.back().size));
+    }
+
     std::shared_ptr<Backing> NCA::CreateBacking(const NcaSectionHeader &sectionHeader, std::shared_ptr<Backing> rawBacking, size_t offset) {
         if (!encrypted)
             return rawBacking;
@@ -76,22 +103,26 @@ namespace skyline::vfs {
             case NcaSectionEncryptionType::None:
                 return rawBacking;
             case NcaSectionEncryptionType::CTR:
-            case NcaSectionEncryptionType::BKTR: {
-                auto key{!rightsIdEmpty ? GetTitleKey() : GetKeyAreaKey(sectionHeader.encryptionType)};
-
-                std::array<u8, 0x10> ctr{};
-                u32 secureValueLE{__builtin_bswap32(sectionHeader.secureValue)};
-                u32 generationLE{__builtin_bswap32(sectionHeader.generation)};
-                std::memcpy(ctr.data(), &secureValueLE, 4);
-                std::memcpy(ctr.data() + 4, &generationLE, 4);
-
-                return std::make_shared<CtrEncryptedBacking>(ctr, key, std::move(rawBacking), offset);
-            }
+            case NcaSectionEncryptionType::BKTR:
+                // Decryption is done prior to caching so repeated reads of the same data are only decrypted once
+                return std::make_shared<CachedBacking>(CreateCtrBacking(sectionHeader, std::move(rawBacking), offset));
             default:
                 return nullptr;
         }
     }
 
+    std::shared_ptr<CtrEncryptedBacking> NCA::CreateCtrBacking(const NcaSectionHeader &sectionHeader, std::shared_ptr<Backing> rawBacking, size_t offset) {
+        auto key{!rightsIdEmpty ? GetTitleKey() : GetKeyAreaKey(sectionHeader.encryptionType)};
+
+        std::array<u8, 0x10> ctr{};
+        u32 secureValueLE{__builtin_bswap32(sectionHeader.secureValue)};
+        u32 generationLE{__builtin_bswap32(sectionHeader.generation)};
+        std::memcpy(ctr.data(), &secureValueLE, 4);
+        std::memcpy(ctr.data() + 4, &generationLE, 4);
+
+        return std::make_shared<CtrEncryptedBacking>(ctr, key, std::move(rawBacking), offset);
+    }
+
     u8 NCA::GetKeyGeneration() {
         u8 legacyGen{static_cast<u8>(header.legacyKeyGenerationType)};
         u8 gen{static_cast<u8>(header.keyGenerationType)};
@@ -7,6 +7,7 @@
 #include <crypto/key_store.h>
 #include <crypto/aes_cipher.h>
 #include "filesystem.h"
+#include "bktr_backing.h"
 
 namespace skyline {
     namespace constant {
@@ -161,7 +162,7 @@ namespace skyline {
                     HierarchicalIntegrityHashInfo integrityHashInfo; //!< The HashInfo used for RomFS
                     HierarchicalSha256HashInfo sha256HashInfo; //!< The HashInfo used for PFS0
                 };
-                u8 _pad1_[0x40]; // PatchInfo
+                BktrBacking::PatchInfo patchInfo; //!< The patch info used for BKTR sections
                 u32 generation; //!< The generation of the NCA section
                 u32 secureValue; //!< The secure value of the section
                 u8 _pad2_[0x30]; //!< SparseInfo
@@ -203,10 +204,17 @@ namespace skyline {
 
             void ReadPfs0(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry);
 
-            void ReadRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry);
+            void ReadRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry, const NCA *baseNca);
+
+            /**
+             * @brief Creates a backing for a BKTR section which patches the RomFS of the base NCA
+             */
+            void ReadPatchRomFs(const NcaSectionHeader &sectionHeader, const NcaFsEntry &entry, const NCA &baseNca);
 
             std::shared_ptr<Backing> CreateBacking(const NcaSectionHeader &sectionHeader, std::shared_ptr<Backing> rawBacking, size_t offset);
 
+            std::shared_ptr<CtrEncryptedBacking> CreateCtrBacking(const NcaSectionHeader &sectionHeader, std::shared_ptr<Backing> rawBacking, size_t offset);
+
             u8 GetKeyGeneration();
 
             crypto::KeyStore::Key128 GetTitleKey();
@@ -218,9 +226,14 @@ namespace skyline {
             std::shared_ptr<FileSystem> logo; //!< The PFS0 filesystem for this NCA's logo section
             std::shared_ptr<FileSystem> cnmt; //!< The PFS0 filesystem for this NCA's CNMT section
             std::shared_ptr<Backing> romFs; //!< The backing for this NCA's RomFS section
+            std::array<u8, 0x20> romFsHash{}; //!< The SHA-256 hash of the RomFS section's header, this uniquely identifies the contents of the RomFS
+            size_t romFsOffset{}; //!< The offset of the RomFS inside its section
             NcaContentType contentType; //!< The content type of the NCA
 
-            NCA(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore);
+            /**
+             * @param baseNca The NCA which is patched by this NCA, this is required to read the RomFS of a patch NCA
+             */
+            NCA(const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<crypto::KeyStore> &keyStore, const NCA *baseNca = nullptr);
         };
     }
 }
\ No newline at end of file
@@ -3,27 +3,65 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #include "os_backing.h"
 
 namespace skyline::vfs {
-    OsBacking::OsBacking(int fd, bool closable, Mode mode) : Backing(mode), fd(fd), closable(closable) {
+    OsBacking::OsBacking(int fd, bool closable, Mode mode, bool map) : Backing(mode), fd(fd), closable(closable) {
         struct stat fileInfo;
         if (fstat(fd, &fileInfo))
             throw exception("Failed to stat fd: {}", strerror(errno));
 
         size = fileInfo.st_size;
+
+        if (map && mode.read && !mode.write && !mode.append && size) {
+            auto address{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+            if (address != MAP_FAILED)
+                mapping = static_cast<u8 *>(address);
+            else
+                syslog(LOG_WARNING, "Failed to map fd, falling back to pread64: %s", strerror(errno));
+        }
     }
 
     OsBacking::~OsBacking() {
+        if (mapping)
+            munmap(mapping, size);
         if (closable)
             close(fd);
     }
 
+    void OsBacking::Advise(AccessPattern pattern) {
+        if (!mapping)
+            return;
+
+        int advice{[pattern] {
+            switch (pattern) {
+                case AccessPattern::Sequential:
+                    return MADV_SEQUENTIAL;
+                case AccessPattern::Random:
+                    return MADV_RANDOM;
+                default:
+                    return MADV_NORMAL;
+            }
+        }()};
+
+        if (madvise(mapping, size, advice))
+            syslog(LOG_WARNING, "Failed to advise the access pattern of a mapped fd: %s", strerror(errno));
+    }
+
     size_t OsBacking::Read(u8 *output, size_t offset, size_t size) {
         if (!mode.read)
             throw exception("Attempting to read a backing that is not readable");
 
+        if (mapping) {
+            if (offset >= this->size)
+                return 0;
+            size = std::min(size, this->size - offset);
+            std::memcpy(output, mapping + offset, size);
+            return size;
+        }
+
         auto ret = pread64(fd, output, size, offset);
         if (ret < 0)
             throw exception("Failed to read from fd: {}", strerror(errno));
@@ -43,6 +81,9 @@ namespace skyline::vfs {
     }
 
     void OsBacking::Resize(size_t size) {
+        if (mapping)
+            throw exception("Attempting to resize a mapped backing");
+
         int ret = ftruncate(fd, size);
         if (ret < 0)
             throw exception("Failed to resize file: {}", strerror(errno));
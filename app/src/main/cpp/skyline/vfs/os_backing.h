@@ -13,17 +13,38 @@ namespace skyline::vfs {
       private:
         int fd; //!< An FD to the backing
         bool closable; //!< Whether the FD can be closed when the backing is destroyed
+        u8 *mapping{}; //!< A read-only mapping of the entire file, this is nullptr if the file isn't mapped
 
       public:
+        /**
+         * @brief This enumerates the access patterns that can be hinted to the kernel for a mapped backing
+         */
+        enum class AccessPattern {
+            Normal, //!< No particular access pattern
+            Sequential, //!< The file is read sequentially, pages are read ahead aggressively and freed soon after being read
+            Random, //!< The file is read randomly, read ahead is disabled
+        };
+
         /**
          * @param fd The file descriptor of the backing
+         * @param map If the file should be mapped into memory so reads are copies from the page cache rather than syscalls, this is only done for read-only backings and reads fall back to pread64 if mapping fails
+         * @note A mapped file must not be truncated by anyone while the backing exists
          */
-        OsBacking(int fd, bool closable = false, Mode = {true, false, false});
+        OsBacking(int fd, bool closable = false, Mode = {true, false, false}, bool map = false);
 
         ~OsBacking();
 
+        /**
+         * @brief Hints the kernel about how the file will be accessed, this does nothing if the file isn't mapped
+         */
+        void Advise(AccessPattern pattern);
+
         size_t Read(u8 *output, size_t offset, size_t size);
 
+        u8 *GetMapping() {
+            return mapping;
+        }
+
         size_t Write(u8 *output, size_t offset, size_t size);
 
         void Resize(size_t size);
@@ -1,11 +1,13 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <profile.h>
 #include "region_backing.h"
 #include "partition_filesystem.h"
 
 namespace skyline::vfs {
     PartitionFileSystem::PartitionFileSystem(std::shared_ptr<Backing> backing) : FileSystem(), backing(backing) {
+        profile::ScopedTimer timer{profile::Stage::Pfs0Index};
         backing->Read(&header);
 
         if (header.magic == util::MakeMagic<u32>("PFS0"))
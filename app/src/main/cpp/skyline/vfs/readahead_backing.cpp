@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#include "readahead_backing.h"
+
+namespace skyline::vfs {
+    IoWorkerPool::IoWorkerPool(size_t threadCount) {
+        for (size_t index{}; index < threadCount; index++)
+            threads.emplace_back(&IoWorkerPool::Run, this);
+    }
+
+    IoWorkerPool::~IoWorkerPool() {
+        {
+            std::lock_guard guard(mutex);
+            running = false;
+        }
+        condition.notify_all();
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    IoWorkerPool &IoWorkerPool::Get() {
+        static IoWorkerPool pool(constant::ReadaheadWorkerCount);
+        return pool;
+    }
+
+    void IoWorkerPool::Run() {
+        pthread_setname_np(pthread_self(), "Skyline-IO");
+
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [this] { return !tasks.empty() || !running; });
+                if (tasks.empty())
+                    return;
+
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            task();
+        }
+    }
+
+    void IoWorkerPool::Submit(std::function<void()> &&task) {
+        {
+            std::lock_guard guard(mutex);
+            tasks.push(std::move(task));
+        }
+        condition.notify_one();
+    }
+
+    ReadaheadBacking::ReadaheadBacking(std::shared_ptr<Backing> pBacking) : Backing({true, false, false}, pBacking->size), backing(std::move(pBacking)) {}
+
+    size_t ReadaheadBacking::ReadBuffered(std::unique_lock<std::mutex> &lock, u8 *output, size_t offset, size_t size) {
+        size_t read{};
+        while (read < size) {
+            auto position{offset + read};
+            auto buffer{std::find_if(buffers.begin(), buffers.end(), [position](const Buffer &buffer) { return buffer.Contains(position); })};
+            if (buffer == buffers.end())
+                break;
+
+            if (buffer->state == Buffer::State::Pending) {
+                bufferCondition.wait(lock, [buffer] { return buffer->state != Buffer::State::Pending; });
+                continue; // The prefetch might've failed or been shorter than requested, so the lookup is redone
+            }
+
+            auto copySize{std::min(size - read, buffer->End() - position)};
+            std::memcpy(output + read, buffer->data.data() + (position - buffer->offset), copySize);
+            read += copySize;
+        }
+
+        return read;
+    }
+
+    void ReadaheadBacking::Prefetch(size_t offset) {
+        if (offset >= this->size)
+            return;
+
+        // The prefetch starts after any data that is already buffered or being buffered
+        for (bool moved{true}; moved;) {
+            moved = false;
+            for (auto &buffer : buffers) {
+                if (buffer.Contains(offset)) {
+                    offset = buffer.End();
+                    moved = true;
+                }
+            }
+        }
+        if (offset >= this->size)
+            return;
+
+        // Buffers that don't hold the region being read or anything after it have been consumed and can be reused
+        auto buffer{std::find_if(buffers.begin(), buffers.end(), [this](const Buffer &buffer) {
+            return buffer.state == Buffer::State::Empty || (buffer.state == Buffer::State::Ready && buffer.End() <= lastEnd);
+        })};
+        if (buffer == buffers.end())
+            return;
+
+        auto prefetchSize{std::min(window, this->size - offset)};
+        buffer->state = Buffer::State::Pending;
+        buffer->offset = offset;
+        buffer->size = 0;
+        buffer->data.resize(prefetchSize);
+
+        IoWorkerPool::Get().Submit([self = shared_from_this(), buffer, offset, prefetchSize] {
+            size_t read{};
+            try {
+                std::lock_guard backingGuard(self->backingLock);
+                read = self->backing->Read(buffer->data.data(), offset, prefetchSize);
+            } catch (const std::exception &) {
+                // A failed prefetch leaves the buffer empty, the data will be read synchronously and the error will be reported there
+            }
+
+            {
+                std::lock_guard stateGuard(self->stateLock);
+                buffer->size = read;
+                buffer->state = read ? Buffer::State::Ready : Buffer::State::Empty;
+            }
+            self->bufferCondition.notify_all();
+        });
+    }
+
+    size_t ReadaheadBacking::Read(u8 *output, size_t offset, size_t size) {
+        if (offset >= this->size)
+            return 0;
+        size = std::min(size, this->size - offset);
+
+        std::unique_lock stateGuard(stateLock);
+        auto read{ReadBuffered(stateGuard, output, offset, size)};
+
+        bool sequential{offset == lastEnd};
+        window = sequential ? std::min(window * 2, constant::ReadaheadMaxWindow) : constant::ReadaheadMinWindow;
+        lastEnd = offset + size;
+        stateGuard.unlock();
+
+        // The unbuffered remainder is read before queueing a prefetch, otherwise the prefetch could take the backing first and delay this read
+        if (read < size) {
+            std::lock_guard backingGuard(backingLock);
+            read += backing->Read(output + read, offset + read, size - read);
+        }
+
+        if (sequential) {
+            stateGuard.lock();
+            Prefetch(offset + size);
+        }
+
+        return read;
+    }
+}
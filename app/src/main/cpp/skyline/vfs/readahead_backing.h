@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <queue>
+#include <thread>
+#include <condition_variable>
+#include "backing.h"
+
+namespace skyline {
+    namespace constant {
+        constexpr size_t ReadaheadMinWindow{128 * 1024}; //!< The amount of data that is prefetched once a sequential access pattern is detected
+        constexpr size_t ReadaheadMaxWindow{2 * 1024 * 1024}; //!< The maximum amount of data that is prefetched at once, the window doubles with every sequential read until it reaches this
+        constexpr size_t ReadaheadWorkerCount{2}; //!< The amount of threads that perform prefetches for all backings
+    }
+
+    namespace vfs {
+        /**
+         * @brief The IoWorkerPool class is a pool of threads that performs asynchronous backing I/O
+         */
+        class IoWorkerPool {
+          private:
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable condition; //!< Signalled when a task is submitted or the pool is stopped
+            std::queue<std::function<void()>> tasks;
+            bool running{true};
+
+            void Run();
+
+          public:
+            IoWorkerPool(size_t threadCount);
+
+            ~IoWorkerPool();
+
+            /**
+             * @return The pool shared by all backings, it's created on the first call
+             */
+            static IoWorkerPool &Get();
+
+            /**
+             * @brief Queues a task to be run on one of the worker threads
+             */
+            void Submit(std::function<void()> &&task);
+        };
+
+        /**
+         * @brief The ReadaheadBacking class detects sequential reads of another backing and prefetches data after them on an IoWorkerPool, this allows large streaming reads to overlap with guest execution
+         * @note This works with any backing as all reads from the underlying backing are serialized, it must be created with std::make_shared as prefetches hold a reference to it
+         */
+        class ReadaheadBacking : public Backing, public std::enable_shared_from_this<ReadaheadBacking> {
+          private:
+            static constexpr size_t BufferCount{2}; //!< The amount of prefetch buffers, this allows reading from one while the next one is being filled
+
+            /**
+             * @brief A buffer holding a prefetched region of the backing
+             */
+            struct Buffer {
+                enum class State {
+                    Empty, //!< The buffer doesn't hold any data
+                    Pending, //!< The buffer is being filled by a worker
+                    Ready, //!< The buffer holds the data of its region
+                } state{State::Empty};
+                size_t offset{}; //!< The offset of the region in the backing
+                size_t size{}; //!< The size of the valid data in the buffer
+                std::vector<u8> data;
+
+                /**
+                 * @return The end of the region held by the buffer, for a pending buffer this is the end of the region being prefetched
+                 */
+                inline size_t End() const {
+                    return offset + (state == State::Pending ? data.size() : size);
+                }
+
+                inline bool Contains(size_t position) const {
+                    return state != State::Empty && position >= offset && position < End();
+                }
+            };
+
+            std::shared_ptr<Backing> backing;
+            std::mutex backingLock; //!< Serializes reads from the underlying backing
+            std::mutex stateLock; //!< Protects the state of the buffers and the access pattern detection
+            std::condition_variable bufferCondition; //!< Signalled when a prefetch completes
+            std::array<Buffer, BufferCount> buffers;
+            size_t lastEnd{std::numeric_limits<size_t>::max()}; //!< The end of the previous read, a read starting here is considered sequential, this starts out as a sentinel so the first read is never sequential
+            size_t window{constant::ReadaheadMinWindow}; //!< The size of the next prefetch
+
+            /**
+             * @brief Copies as much data as possible from the prefetch buffers, this waits on any pending prefetch covering the requested data
+             * @return The amount of bytes copied from the start of the requested region
+             */
+            size_t ReadBuffered(std::unique_lock<std::mutex> &lock, u8 *output, size_t offset, size_t size);
+
+            /**
+             * @brief Starts prefetching the region after the specified offset if it isn't already buffered and a buffer is available
+             */
+            void Prefetch(size_t offset);
+
+          public:
+            ReadaheadBacking(std::shared_ptr<Backing> backing);
+
+            size_t Read(u8 *output, size_t offset, size_t size) override;
+        };
+    }
+}
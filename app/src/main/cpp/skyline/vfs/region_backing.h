@@ -28,7 +28,18 @@ namespace skyline::vfs {
 
             size = std::min(offset + size, this->size) - offset;
 
+            auto mapping{GetMapping()};
+            if (mapping) {
+                std::memcpy(output, mapping + offset, size);
+                return size;
+            }
+
             return backing->Read(output, baseOffset + offset, size);
         }
+
+        inline u8 *GetMapping() {
+            auto mapping{backing->GetMapping()};
+            return mapping ? mapping + baseOffset : nullptr;
+        }
     };
 }
@@ -1,125 +1,302 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <profile.h>
+#include "os_backing.h"
 #include "region_backing.h"
 #include "rom_filesystem.h"
 
 namespace skyline::vfs {
-    RomFileSystem::RomFileSystem(std::shared_ptr<Backing> backing) : FileSystem(), backing(backing) {
-        backing->Read(&header);
+    namespace {
+        constexpr u32 IndexVersion{1}; //!< The version of the serialized index format, this must be incremented whenever the layout or the path hash changes
+
+        /**
+         * @brief Reads an entry and its name from an in-memory metadata table
+         */
+        template<typename EntryType>
+        EntryType ReadEntry(std::span<const u8> table, u32 offset, std::string_view &name) {
+            EntryType entry;
+            if (static_cast<size_t>(offset) + sizeof(EntryType) > table.size())
+                throw exception("RomFS entry at 0x{:X} is out of bounds", offset);
+            std::memcpy(&entry, table.data() + offset, sizeof(EntryType));
+
+            if (static_cast<size_t>(offset) + sizeof(EntryType) + entry.nameSize > table.size())
+                throw exception("RomFS entry name at 0x{:X} is out of bounds", offset);
+            name = std::string_view(reinterpret_cast<const char *>(table.data() + offset + sizeof(EntryType)), entry.nameSize);
+
+            return entry;
+        }
 
-        TraverseDirectory(0, "");
+        /**
+         * @brief Builds a hash table for the supplied records which is sorted by hash
+         */
+        template<typename Record>
+        std::vector<RomFileSystem::Index::HashSlot> BuildHashTable(const std::vector<Record> &records, std::string_view stringPool) {
+            std::vector<RomFileSystem::Index::HashSlot> slots(records.size());
+            for (u32 index{}; index < records.size(); index++)
+                slots[index] = {RomFileSystem::Index::HashPath(stringPool.substr(records[index].pathOffset, records[index].pathSize)), index};
+
+            std::sort(slots.begin(), slots.end(), [](const auto &a, const auto &b) { return a.hash < b.hash || (a.hash == b.hash && a.index < b.index); });
+            return slots;
+        }
     }
 
-    void RomFileSystem::TraverseFiles(u32 offset, const std::string &path) {
-        RomFsFileEntry entry{};
+    RomFileSystem::Index::Index(Backing &backing, const RomFsHeader &header) {
+        // The metadata tables are read in their entirety as traversing them on the backing would require multiple small reads for every entry
+        std::vector<u8> directoryTable(header.dirMetaTableSize), fileTable(header.fileMetaTableSize);
+        if (backing.Read(directoryTable.data(), header.dirMetaTableOffset, directoryTable.size()) != directoryTable.size() || backing.Read(fileTable.data(), header.fileMetaTableOffset, fileTable.size()) != fileTable.size())
+            throw exception("RomFS metadata tables are truncated");
 
-        do {
-            backing->Read(&entry, header.fileMetaTableOffset + offset);
+        std::vector<DirectoryRecord> directoryRecords{DirectoryRecord{}};
+        std::vector<u32> directoryOffsets{0}; // The offset of the entry of every directory record in the directory metadata table
+        std::vector<FileRecord> fileRecords;
+        std::string pool;
+
+        auto appendPath{[&pool](const DirectoryRecord &parent, std::string_view name) {
+            auto pathOffset{static_cast<u32>(pool.size())};
+            if (parent.pathSize) {
+                pool.append(pool, parent.pathOffset, parent.pathSize);
+                pool.push_back('/');
+            }
+            pool.append(name);
 
-            if (entry.nameSize) {
-                std::vector<char> name(entry.nameSize);
-                backing->Read(name.data(), header.fileMetaTableOffset + offset + sizeof(RomFsFileEntry), entry.nameSize);
+            if (pool.size() > std::numeric_limits<u32>::max())
+                throw exception("RomFS paths exceed the size of the string pool");
+            return std::pair{pathOffset, static_cast<u32>(pool.size() - pathOffset)};
+        }};
 
-                std::string fullPath = path + (path.empty() ? "" : "/") + std::string(name.data(), entry.nameSize);
-                fileMap.emplace(fullPath, entry);
+        // Any more entries than could fit into the tables can only be caused by a cycle in the sibling chains
+        size_t directoryVisits{}, fileVisits{};
+        auto maxDirectoryVisits{directoryTable.size() / sizeof(RomFsDirectoryEntry)}, maxFileVisits{fileTable.size() / sizeof(RomFsFileEntry)};
+
+        // The directories are traversed breadth-first so the children of a directory are contiguous in the records
+        for (size_t index{}; index < directoryRecords.size(); index++) {
+            std::string_view name;
+            auto entry{ReadEntry<RomFsDirectoryEntry>(directoryTable, directoryOffsets[index], name)};
+            auto parent{directoryRecords[index]};
+
+            parent.childIndex = static_cast<u32>(directoryRecords.size());
+            for (u32 offset{entry.childOffset}; offset != constant::RomFsEmptyEntry;) {
+                if (++directoryVisits > maxDirectoryVisits)
+                    throw exception("RomFS directory tree contains a cycle");
+
+                auto child{ReadEntry<RomFsDirectoryEntry>(directoryTable, offset, name)};
+                if (child.nameSize) {
+                    auto [pathOffset, pathSize]{appendPath(parent, name)};
+                    directoryRecords.push_back(DirectoryRecord{pathOffset, pathSize, child.nameSize});
+                    directoryOffsets.push_back(offset);
+                }
+                offset = child.siblingOffset;
             }
+            parent.childCount = static_cast<u32>(directoryRecords.size() - parent.childIndex);
 
-            offset = entry.siblingOffset;
-        } while (offset != constant::RomFsEmptyEntry);
-    }
+            parent.fileIndex = static_cast<u32>(fileRecords.size());
+            for (u32 offset{entry.fileOffset}; offset != constant::RomFsEmptyEntry;) {
+                if (++fileVisits > maxFileVisits)
+                    throw exception("RomFS file list contains a cycle");
 
-    void RomFileSystem::TraverseDirectory(u32 offset, const std::string &path) {
-        RomFsDirectoryEntry entry{};
-        backing->Read(&entry, header.dirMetaTableOffset + offset);
+                auto file{ReadEntry<RomFsFileEntry>(fileTable, offset, name)};
+                if (file.nameSize) {
+                    auto [pathOffset, pathSize]{appendPath(parent, name)};
+                    fileRecords.push_back(FileRecord{file.offset, file.size, pathOffset, pathSize, file.nameSize});
+                }
+                offset = file.siblingOffset;
+            }
+            parent.fileCount = static_cast<u32>(fileRecords.size() - parent.fileIndex);
 
-        std::string childPath = path;
-        if (entry.nameSize) {
-            std::vector<char> name(entry.nameSize);
-            backing->Read(name.data(), header.dirMetaTableOffset + offset + sizeof(RomFsDirectoryEntry), entry.nameSize);
-            childPath = path + (path.empty() ? "" : "/") + std::string(name.data(), entry.nameSize);
+            directoryRecords[index] = parent;
         }
 
-        directoryMap.emplace(childPath, entry);
+        auto directoryHashes{BuildHashTable(directoryRecords, pool)};
+        auto fileHashes{BuildHashTable(fileRecords, pool)};
 
-        if (entry.fileOffset != constant::RomFsEmptyEntry)
-            TraverseFiles(entry.fileOffset, childPath);
+        IndexHeader indexHeader{};
+        indexHeader.magic = util::MakeMagic<u32>("RFSI");
+        indexHeader.version = IndexVersion;
+        indexHeader.romFsHeader = header;
+        indexHeader.directoryCount = static_cast<u32>(directoryRecords.size());
+        indexHeader.fileCount = static_cast<u32>(fileRecords.size());
+        indexHeader.stringPoolSize = static_cast<u32>(pool.size());
 
-        if (entry.childOffset != constant::RomFsEmptyEntry)
-            TraverseDirectory(entry.childOffset, childPath);
+        storage.resize(sizeof(IndexHeader) + directoryRecords.size() * (sizeof(DirectoryRecord) + sizeof(HashSlot)) + fileRecords.size() * (sizeof(FileRecord) + sizeof(HashSlot)) + pool.size());
+        auto pointer{storage.data()};
+        auto append{[&pointer](const void *data, size_t size) {
+            std::memcpy(pointer, data, size);
+            pointer += size;
+        }};
+        append(&indexHeader, sizeof(IndexHeader));
+        append(directoryRecords.data(), directoryRecords.size() * sizeof(DirectoryRecord));
+        append(fileRecords.data(), fileRecords.size() * sizeof(FileRecord));
+        append(directoryHashes.data(), directoryHashes.size() * sizeof(HashSlot));
+        append(fileHashes.data(), fileHashes.size() * sizeof(HashSlot));
+        append(pool.data(), pool.size());
 
-        if (entry.siblingOffset != constant::RomFsEmptyEntry)
-            TraverseDirectory(entry.siblingOffset, path);
+        Parse(storage, header);
     }
 
-    std::shared_ptr<Backing> RomFileSystem::OpenFile(const std::string &path, Backing::Mode mode) {
-        try {
-            const auto &entry = fileMap.at(path);
-            return std::make_shared<RegionBacking>(backing, header.dataOffset + entry.offset, entry.size, mode);
-        } catch (std::out_of_range &e) {
-            return nullptr;
-        }
+    RomFileSystem::Index::Index(std::shared_ptr<Backing> pMapping, const RomFsHeader &header) : mapping(std::move(pMapping)) {
+        auto data{mapping->GetMapping()};
+        if (!data)
+            throw exception("RomFS index file couldn't be mapped");
+
+        Parse(std::span<const u8>(data, mapping->size), header);
     }
 
-    std::optional<Directory::EntryType> RomFileSystem::GetEntryType(const std::string &path) {
-        if (fileMap.count(path))
-            return Directory::EntryType::File;
-        else if (directoryMap.count(path))
-            return Directory::EntryType::Directory;
+    void RomFileSystem::Index::Parse(std::span<const u8> data, const RomFsHeader &header) {
+        IndexHeader indexHeader;
+        if (data.size() < sizeof(IndexHeader))
+            throw exception("RomFS index is truncated");
+        std::memcpy(&indexHeader, data.data(), sizeof(IndexHeader));
 
-        return std::nullopt;
+        if (indexHeader.magic != util::MakeMagic<u32>("RFSI") || indexHeader.version != IndexVersion)
+            throw exception("RomFS index has an unsupported format");
+        if (std::memcmp(&indexHeader.romFsHeader, &header, sizeof(RomFsHeader)))
+            throw exception("RomFS index was built from a different RomFS");
+
+        size_t directoryCount{indexHeader.directoryCount}, fileCount{indexHeader.fileCount}, poolSize{indexHeader.stringPoolSize};
+        if (!directoryCount || data.size() != sizeof(IndexHeader) + directoryCount * (sizeof(DirectoryRecord) + sizeof(HashSlot)) + fileCount * (sizeof(FileRecord) + sizeof(HashSlot)) + poolSize)
+            throw exception("RomFS index size doesn't match its header");
+
+        auto pointer{data.data() + sizeof(IndexHeader)};
+        directories = std::span(reinterpret_cast<const DirectoryRecord *>(pointer), directoryCount);
+        pointer += directories.size_bytes();
+        files = std::span(reinterpret_cast<const FileRecord *>(pointer), fileCount);
+        pointer += files.size_bytes();
+        directorySlots = std::span(reinterpret_cast<const HashSlot *>(pointer), directoryCount);
+        pointer += directorySlots.size_bytes();
+        fileSlots = std::span(reinterpret_cast<const HashSlot *>(pointer), fileCount);
+        pointer += fileSlots.size_bytes();
+        stringPool = std::string_view(reinterpret_cast<const char *>(pointer), poolSize);
+        serialized = data;
+
+        // Every offset in the index is validated once here so lookups can't read outside of it, even if the file was corrupted
+        auto validPath{[poolSize](const auto &record) {
+            return static_cast<size_t>(record.pathOffset) + record.pathSize <= poolSize && record.nameSize <= record.pathSize;
+        }};
+        for (const auto &directory : directories)
+            if (!validPath(directory) || static_cast<size_t>(directory.childIndex) + directory.childCount > directoryCount || static_cast<size_t>(directory.fileIndex) + directory.fileCount > fileCount)
+                throw exception("RomFS index contains an invalid directory record");
+        for (const auto &file : files)
+            if (!validPath(file))
+                throw exception("RomFS index contains an invalid file record");
+        for (const auto &slot : directorySlots)
+            if (slot.index >= directoryCount)
+                throw exception("RomFS index contains an invalid directory hash slot");
+        for (const auto &slot : fileSlots)
+            if (slot.index >= fileCount)
+                throw exception("RomFS index contains an invalid file hash slot");
     }
 
-    std::shared_ptr<Directory> RomFileSystem::OpenDirectory(const std::string &path, Directory::ListMode listMode) {
+    void RomFileSystem::Index::Save(const std::string &path) const {
+        auto temporaryPath{path + ".tmp"};
+        int fd{open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)};
+        if (fd < 0)
+            throw exception("Failed to create RomFS index file: {}", strerror(errno));
+
         try {
-            auto &entry = directoryMap.at(path);
-            return std::make_shared<RomFileSystemDirectory>(backing, header, entry, listMode);
-        } catch (std::out_of_range &e) {
-            return nullptr;
+            OsBacking file(fd, true, Backing::Mode{false, true, false});
+            if (file.Write(const_cast<u8 *>(serialized.data()), 0, serialized.size()) != serialized.size())
+                throw exception("Failed to write the entire RomFS index");
+        } catch (...) {
+            unlink(temporaryPath.c_str());
+            throw;
         }
-    }
 
-    RomFileSystemDirectory::RomFileSystemDirectory(const std::shared_ptr<Backing> &backing, const RomFileSystem::RomFsHeader &header, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode) : Directory(listMode), backing(backing), header(header), ownEntry(ownEntry) {}
+        if (rename(temporaryPath.c_str(), path.c_str())) {
+            unlink(temporaryPath.c_str());
+            throw exception("Failed to move RomFS index file into place: {}", strerror(errno));
+        }
+    }
 
-    std::vector<RomFileSystemDirectory::Entry> RomFileSystemDirectory::Read() {
-        std::vector<Entry> contents;
+    template<typename Record>
+    const Record *RomFileSystem::Index::Find(std::span<const HashSlot> slots, std::span<const Record> records, std::string_view path) const {
+        auto hash{HashPath(path)};
+        auto slot{std::lower_bound(slots.begin(), slots.end(), hash, [](const HashSlot &slot, u32 hash) { return slot.hash < hash; })};
+        for (; slot != slots.end() && slot->hash == hash; slot++) {
+            const auto &record{records[slot->index]};
+            if (stringPool.substr(record.pathOffset, record.pathSize) == path)
+                return &record;
+        }
+        return nullptr;
+    }
 
-        if (listMode.file) {
-            RomFileSystem::RomFsFileEntry romFsFileEntry;
-            u32 offset = ownEntry.fileOffset;
+    const RomFileSystem::Index::DirectoryRecord *RomFileSystem::Index::FindDirectory(std::string_view path) const {
+        return Find(directorySlots, directories, path);
+    }
 
-            do {
-                backing->Read(&romFsFileEntry, header.fileMetaTableOffset + offset);
+    const RomFileSystem::Index::FileRecord *RomFileSystem::Index::FindFile(std::string_view path) const {
+        return Find(fileSlots, files, path);
+    }
 
-                if (romFsFileEntry.nameSize) {
-                    std::vector<char> name(romFsFileEntry.nameSize);
-                    backing->Read(name.data(), header.fileMetaTableOffset + offset + sizeof(RomFileSystem::RomFsFileEntry), romFsFileEntry.nameSize);
+    RomFileSystem::RomFileSystem(std::shared_ptr<Backing> pBacking, const std::string &indexPath) : FileSystem(), backing(std::move(pBacking)) {
+        profile::ScopedTimer timer{profile::Stage::RomFsIndex};
+        backing->Read(&header);
 
-                    contents.emplace_back(Entry{std::string(name.data(), romFsFileEntry.nameSize), EntryType::File});
+        if (!indexPath.empty()) {
+            int fd{open(indexPath.c_str(), O_RDONLY)};
+            if (fd >= 0) {
+                try {
+                    index = std::make_shared<Index>(std::make_shared<OsBacking>(fd, true, Backing::Mode{true, false, false}, true), header);
+                } catch (const std::exception &e) {
+                    syslog(LOG_WARNING, "Rebuilding RomFS index: %s", e.what());
                 }
+            }
+        }
 
-                offset = romFsFileEntry.siblingOffset;
-            } while (offset != constant::RomFsEmptyEntry);
+        if (!index) {
+            index = std::make_shared<Index>(*backing, header);
+
+            if (!indexPath.empty()) {
+                try {
+                    index->Save(indexPath);
+                } catch (const std::exception &e) {
+                    syslog(LOG_WARNING, "Failed to save RomFS index: %s", e.what());
+                }
+            }
         }
+    }
 
-        if (listMode.directory) {
-            RomFileSystem::RomFsDirectoryEntry romFsDirectoryEntry;
-            u32 offset = ownEntry.childOffset;
+    std::shared_ptr<Backing> RomFileSystem::OpenFile(const std::string &path, Backing::Mode mode) {
+        auto file{index->FindFile(path)};
+        if (!file)
+            return nullptr;
 
-            do {
-                backing->Read(&romFsDirectoryEntry, header.dirMetaTableOffset + offset);
+        return std::make_shared<RegionBacking>(backing, header.dataOffset + file->offset, file->size, mode);
+    }
 
-                if (romFsDirectoryEntry.nameSize) {
-                    std::vector<char> name(romFsDirectoryEntry.nameSize);
-                    backing->Read(name.data(), header.dirMetaTableOffset + offset + sizeof(RomFileSystem::RomFsDirectoryEntry), romFsDirectoryEntry.nameSize);
+    std::optional<Directory::EntryType> RomFileSystem::GetEntryType(const std::string &path) {
+        if (index->FindFile(path))
+            return Directory::EntryType::File;
+        else if (index->FindDirectory(path))
+            return Directory::EntryType::Directory;
 
-                    contents.emplace_back(Entry{std::string(name.data(), romFsDirectoryEntry.nameSize), EntryType::Directory});
-                }
+        return std::nullopt;
+    }
 
-                offset = romFsDirectoryEntry.siblingOffset;
-            } while (offset != constant::RomFsEmptyEntry);
-        }
+    std::shared_ptr<Directory> RomFileSystem::OpenDirectory(const std::string &path, Directory::ListMode listMode) {
+        auto directory{index->FindDirectory(path)};
+        if (!directory)
+            return nullptr;
+
+        return std::make_shared<RomFileSystemDirectory>(index, *directory, listMode);
+    }
+
+    RomFileSystemDirectory::RomFileSystemDirectory(std::shared_ptr<RomFileSystem::Index> index, const RomFileSystem::Index::DirectoryRecord &ownRecord, ListMode listMode) : Directory(listMode), index(std::move(index)), ownRecord(ownRecord) {}
+
+    std::vector<RomFileSystemDirectory::Entry> RomFileSystemDirectory::Read() {
+        std::vector<Entry> contents;
+        contents.reserve((listMode.file ? ownRecord.fileCount : 0) + (listMode.directory ? ownRecord.childCount : 0));
+
+        if (listMode.file)
+            for (const auto &file : index->files.subspan(ownRecord.fileIndex, ownRecord.fileCount))
+                contents.emplace_back(Entry{std::string(index->GetName(file)), EntryType::File});
+
+        if (listMode.directory)
+            for (const auto &directory : index->directories.subspan(ownRecord.childIndex, ownRecord.childCount))
+                contents.emplace_back(Entry{std::string(index->GetName(directory)), EntryType::Directory});
 
         return contents;
     }
-}
\ No newline at end of file
+}
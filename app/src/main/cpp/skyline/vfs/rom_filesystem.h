@@ -13,25 +13,9 @@ namespace skyline {
     namespace vfs {
         /**
          * @brief The RomFileSystem class abstracts access to a RomFS image using the vfs::FileSystem api
+         * @note The directory tree is flattened into an index once and can be persisted to a file, subsequent constructions with the same index path map the index rather than traversing the tree
          */
         class RomFileSystem : public FileSystem {
-          private:
-            std::shared_ptr<Backing> backing; //!< The backing file of the filesystem
-
-            /**
-             * @brief Traverses the sibling files of the given file and adds them to the file map
-             * @param offset The offset of the file entry to traverses the siblings of
-             * @param path The path to the parent directory of the supplied file entry
-             */
-            void TraverseFiles(u32 offset, const std::string &path);
-
-            /**
-             * @brief Traverses the directories within the given directory, adds them to the directory map and calls TraverseFiles on them
-             * @param offset The offset of the directory entry to traverses the directories in
-             * @param path The path to the supplied directory entry
-             */
-            void TraverseDirectory(u32 offset, const std::string &path);
-
           public:
             /**
              * @brief This holds the header of a RomFS image
@@ -74,10 +58,138 @@ namespace skyline {
                 u32 nameSize; //!< The size of the file's name in bytes
             };
 
-            std::unordered_map<std::string, RomFsFileEntry> fileMap; //!< A map that maps file names to their corresponding entry
-            std::unordered_map<std::string, RomFsDirectoryEntry> directoryMap; //!< A map that maps directory names to their corresponding entry
+            /**
+             * @brief A flat index of every entry in a RomFS image, it is stored in a single contiguous buffer with the same layout as the serialized index so it can be used directly from a mapping of the index file
+             * @note Directories are laid out in breadth-first order so that the subdirectories and files of a directory are contiguous, paths are stored in a string pool and are looked up through tables of path hashes sorted by hash
+             */
+            class Index {
+              public:
+                /**
+                 * @brief The header of a serialized index
+                 */
+                struct IndexHeader {
+                    u32 magic; //!< The magic of the index: 'RFSI'
+                    u32 version; //!< The version of the index format, an index with a different version is rebuilt
+                    RomFsHeader romFsHeader; //!< The header of the RomFS the index was built from, this is used to detect a stale index
+                    u32 directoryCount; //!< The amount of directory records
+                    u32 fileCount; //!< The amount of file records
+                    u32 stringPoolSize; //!< The size of the string pool in bytes
+                    u32 _pad_;
+                };
+                static_assert(sizeof(IndexHeader) == 0x68);
+
+                /**
+                 * @brief A single directory in the index
+                 */
+                struct DirectoryRecord {
+                    u32 pathOffset; //!< The offset of the full path of the directory in the string pool
+                    u32 pathSize; //!< The size of the full path of the directory
+                    u32 nameSize; //!< The size of the directory's name, the name is the last part of the path
+                    u32 childIndex; //!< The index of the first subdirectory
+                    u32 childCount; //!< The amount of subdirectories
+                    u32 fileIndex; //!< The index of the first file
+                    u32 fileCount; //!< The amount of files
+                    u32 _pad_;
+                };
+                static_assert(sizeof(DirectoryRecord) == 0x20);
+
+                /**
+                 * @brief A single file in the index
+                 */
+                struct FileRecord {
+                    u64 offset; //!< The offset from the file data base of the file contents
+                    u64 size; //!< The size of the file in bytes
+                    u32 pathOffset; //!< The offset of the full path of the file in the string pool
+                    u32 pathSize; //!< The size of the full path of the file
+                    u32 nameSize; //!< The size of the file's name, the name is the last part of the path
+                    u32 _pad_;
+                };
+                static_assert(sizeof(FileRecord) == 0x20);
+
+                /**
+                 * @brief An entry in a hash table which maps the hash of a path to the index of its record
+                 */
+                struct HashSlot {
+                    u32 hash; //!< The hash of the full path
+                    u32 index; //!< The index of the record with the path
+                };
+                static_assert(sizeof(HashSlot) == 0x8);
+
+              private:
+                std::vector<u8> storage; //!< The storage of an index that was built in memory
+                std::shared_ptr<Backing> mapping; //!< The mapped file backing of an index that was loaded from a file
+                std::span<const u8> serialized; //!< The entire serialized index, this is either in the storage or the mapping
+
+                /**
+                 * @brief Looks up a record by its path in a hash table
+                 */
+                template<typename Record>
+                const Record *Find(std::span<const HashSlot> slots, std::span<const Record> records, std::string_view path) const;
+
+              public:
+                std::span<const DirectoryRecord> directories; //!< The directory records, the first one is the root directory
+                std::span<const FileRecord> files; //!< The file records
+                std::span<const HashSlot> directorySlots; //!< The hash table of the directories
+                std::span<const HashSlot> fileSlots; //!< The hash table of the files
+                std::string_view stringPool; //!< The string pool containing the paths of every entry
+
+                /**
+                 * @brief Builds the index by traversing the directory tree of a RomFS image
+                 */
+                Index(Backing &backing, const RomFsHeader &header);
+
+                /**
+                 * @brief Uses a serialized index from a mapped file
+                 * @param mapping A backing of the index file, this must be mapped
+                 * @note An exception is thrown if the index is invalid or doesn't belong to the RomFS with the supplied header
+                 */
+                Index(std::shared_ptr<Backing> mapping, const RomFsHeader &header);
+
+                /**
+                 * @return The hash of a path as it's stored in the hash tables
+                 */
+                static constexpr u32 HashPath(std::string_view path) {
+                    u32 hash{0x811C9DC5}; // 32-bit FNV-1a, this needs to be stable across builds as it is persisted
+                    for (char character : path)
+                        hash = (hash ^ static_cast<u8>(character)) * 0x01000193;
+                    return hash;
+                }
+
+                /**
+                 * @brief Points the spans at a serialized index after validating it
+                 */
+                void Parse(std::span<const u8> data, const RomFsHeader &header);
+
+                /**
+                 * @brief Writes the serialized index to a file, this is done atomically so a partially written index is never read
+                 */
+                void Save(const std::string &path) const;
+
+                /**
+                 * @return The record of the directory at the supplied path or nullptr if it doesn't exist
+                 */
+                const DirectoryRecord *FindDirectory(std::string_view path) const;
+
+                /**
+                 * @return The record of the file at the supplied path or nullptr if it doesn't exist
+                 */
+                const FileRecord *FindFile(std::string_view path) const;
+
+                template<typename Record>
+                std::string_view GetName(const Record &record) const {
+                    return stringPool.substr(record.pathOffset + record.pathSize - record.nameSize, record.nameSize);
+                }
+            };
 
-            RomFileSystem(std::shared_ptr<Backing> backing);
+          private:
+            std::shared_ptr<Backing> backing; //!< The backing file of the filesystem
+            std::shared_ptr<Index> index; //!< The index of all entries in the filesystem
+
+          public:
+            /**
+             * @param indexPath The path to persist the index at, the index is loaded from it if it's valid and written to it otherwise, an empty path disables persisting the index
+             */
+            RomFileSystem(std::shared_ptr<Backing> backing, const std::string &indexPath = {});
 
             std::shared_ptr<Backing> OpenFile(const std::string &path, Backing::Mode mode = {true, false, false});
 
@@ -91,12 +203,11 @@ namespace skyline {
          */
         class RomFileSystemDirectory : public Directory {
           private:
-            RomFileSystem::RomFsDirectoryEntry ownEntry; //!< This directory's entry in the RomFS header
-            RomFileSystem::RomFsHeader header; //!< A header of this files parent RomFS image
-            std::shared_ptr<Backing> backing; //!< The backing of the RomFS image
+            std::shared_ptr<RomFileSystem::Index> index; //!< The index of the parent RomFS image
+            const RomFileSystem::Index::DirectoryRecord &ownRecord; //!< This directory's record in the index
 
           public:
-            RomFileSystemDirectory(const std::shared_ptr<Backing> &backing, const RomFileSystem::RomFsHeader &header, const RomFileSystem::RomFsDirectoryEntry &ownEntry, ListMode listMode);
+            RomFileSystemDirectory(std::shared_ptr<RomFileSystem::Index> index, const RomFileSystem::Index::DirectoryRecord &ownRecord, ListMode listMode);
 
             std::vector<Entry> Read();
         };
@@ -23,6 +23,11 @@ import kotlin.math.abs
 class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTouchListener {
     companion object {
         private val Tag = EmulationActivity::class.java.name
+
+        /**
+         * The name of an optional [Uri] extra in the intent which points to an update NSP for the ROM
+         */
+        const val UpdateExtra = "update"
     }
 
     init {
@@ -34,6 +39,11 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
      */
     private lateinit var romFd : ParcelFileDescriptor
 
+    /**
+     * The file descriptor of an update NSP for the ROM, if one was supplied in [UpdateExtra]
+     */
+    private var updateFd : ParcelFileDescriptor? = null
+
     /**
      * The file descriptor of the application Preference XML
      */
@@ -82,10 +92,11 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
      * @param romUri The URI of the ROM as a string, used to print out in the logs
      * @param romType The type of the ROM as an enum value
      * @param romFd The file descriptor of the ROM object
+     * @param updateFd The file descriptor of an update NSP for the ROM or -1 if there is none
      * @param preferenceFd The file descriptor of the Preference XML
      * @param appFilesPath The full path to the app files directory
      */
-    private external fun executeApplication(romUri : String, romType : Int, romFd : Int, preferenceFd : Int, appFilesPath : String)
+    private external fun executeApplication(romUri : String, romType : Int, romFd : Int, updateFd : Int, preferenceFd : Int, appFilesPath : String)
 
     /**
      * This sets the halt flag in libskyline to the provided value, if set to true it causes libskyline to halt emulation
@@ -111,6 +122,13 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
      */
     private external fun getFrametime() : Float
 
+    /**
+     * This returns statistics of the audio output, times are in nanoseconds and fill levels are in frames
+     *
+     * @return An array containing the callback count, underrun count, stream xrun count, mean, 99th percentile and maximum callback duration, 99th percentile callback interval, mean and 1st percentile ring fill and mean, 99th percentile and maximum latency or null if emulation isn't running
+     */
+    private external fun getAudioStatistics() : LongArray?
+
     /**
      * This initializes a guest controller in libskyline
      *
@@ -184,15 +202,17 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
      * This executes the specified ROM, [preferenceFd] is assumed to be valid beforehand
      *
      * @param rom The URI of the ROM to execute
+     * @param update The URI of an update NSP for the ROM, if any
      */
-    private fun executeApplication(rom : Uri) {
+    private fun executeApplication(rom : Uri, update : Uri?) {
         val romType = getRomFormat(rom, contentResolver).ordinal
         romFd = contentResolver.openFileDescriptor(rom, "r")!!
+        updateFd = update?.let { contentResolver.openFileDescriptor(it, "r") }
 
         emulationThread = Thread {
             surfaceReady.block()
 
-            executeApplication(rom.toString(), romType, romFd.fd, preferenceFd.fd, applicationContext.filesDir.canonicalPath + "/")
+            executeApplication(rom.toString(), romType, romFd.fd, updateFd?.fd ?: -1, preferenceFd.fd, applicationContext.filesDir.canonicalPath + "/")
 
             if (shouldFinish)
                 runOnUiThread { finish() }
@@ -235,7 +255,10 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
         if (sharedPreferences.getBoolean("perf_stats", false)) {
             perf_stats.postDelayed(object : Runnable {
                 override fun run() {
-                    perf_stats.text = "${getFps()} FPS\n${getFrametime()}ms"
+                    val audioStatistics = getAudioStatistics()
+                    val audioText = if (audioStatistics != null) "\nAudio: ${audioStatistics[9] / 1000000}ms (P99 ${audioStatistics[10] / 1000000}ms)\n${audioStatistics[1]} underruns, ${audioStatistics[2]} xruns" else ""
+
+                    perf_stats.text = "${getFps()} FPS\n${getFrametime()}ms$audioText"
                     perf_stats.postDelayed(this, 250)
                 }
             }, 250)
@@ -248,7 +271,7 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
 
         game_view.setOnTouchListener(this)
 
-        executeApplication(intent.data!!)
+        executeApplication(intent.data!!, intent.getParcelableExtra(UpdateExtra))
     }
 
     /**
@@ -263,8 +286,9 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
         shouldFinish = true
 
         romFd.close()
+        updateFd?.close()
 
-        executeApplication(intent?.data!!)
+        executeApplication(intent?.data!!, intent?.getParcelableExtra(UpdateExtra))
 
         super.onNewIntent(intent)
     }
@@ -282,6 +306,7 @@ class EmulationActivity : AppCompatActivity(), SurfaceHolder.Callback, View.OnTo
         vibrators.clear()
 
         romFd.close()
+        updateFd?.close()
         preferenceFd.close()
 
         super.onDestroy()